@@ -0,0 +1,303 @@
+#include "jace/HandleTable.h"
+
+#include "jace/Jace.h"
+#include "jace/JClassImpl.h"
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+#include "jace/LocalFrame.h"
+using jace::LocalFrame;
+#include "jace/JNIException.h"
+using jace::proxy::JObject;
+
+#include <string>
+using std::string;
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	const string tableClassName = "org/jace/util/HandleTable";
+
+	/**
+	 * The class and methods of org.jace.util.HandleTable, which are only looked up once.
+	 */
+	struct Methods
+	{
+		Methods(): tableClass(tableClassName)
+		{
+			constructor = getMethod("<init>", "(I)V");
+			add = getMethod("add", "(Ljava/lang/Object;)I");
+			addAll = getMethod("addAll", "([Ljava/lang/Object;I)[I");
+			get = getMethod("get", "(I)Ljava/lang/Object;");
+			getAll = getMethod("getAll", "([II)[Ljava/lang/Object;");
+			remove = getMethod("remove", "(I)V");
+			removeAll = getMethod("removeAll", "([II)V");
+			clear = getMethod("clear", "()V");
+			size = getMethod("size", "()I");
+		}
+
+		jmethodID getMethod(const string& name, const string& signature)
+		{
+			jmethodID result = JMemberRegistry::getMethodID(tableClass, name, signature);
+			if (!result)
+			{
+				attach()->ExceptionClear();
+				THROW_JNI_EXCEPTION("HandleTable: Unable to find the method, " + tableClassName + "." + name + "()");
+			}
+			return result;
+		}
+
+		JClassImpl tableClass;
+		jmethodID constructor;
+		jmethodID add;
+		jmethodID addAll;
+		jmethodID get;
+		jmethodID getAll;
+		jmethodID remove;
+		jmethodID removeAll;
+		jmethodID clear;
+		jmethodID size;
+	};
+
+	/**
+	 * The methods, once looked up. They are never released, so that every call after
+	 * the first reads them without taking methodsMutex.
+	 */
+	boost::atomic<Methods*> sharedMethods(0);
+	boost::mutex methodsMutex;
+	const Methods& getMethods()
+	{
+		Methods* result = sharedMethods.load(boost::memory_order_acquire);
+		if (result)
+			return *result;
+
+		boost::mutex::scoped_lock lock(methodsMutex);
+		result = sharedMethods.load(boost::memory_order_relaxed);
+		if (!result)
+		{
+			result = new Methods;
+			sharedMethods.store(result, boost::memory_order_release);
+		}
+		return *result;
+	}
+
+	/**
+	 * Checks that count fits in a java array.
+	 */
+	jsize toArrayLength(size_t count)
+	{
+		if (count > 0x7fffffff)
+			THROW_JNI_EXCEPTION("HandleTable: Too many objects for a single call <" + toString(count) + ">");
+		return static_cast<jsize>(count);
+	}
+} // namespace
+
+
+/**
+ * Creates an empty table.
+ */
+HandleTable::HandleTable(jint capacity)
+{
+	JNIEnv* env = attach();
+	const Methods& methods = getMethods();
+
+	jobject table = env->NewObject(methods.tableClass.getClass(), methods.constructor, capacity);
+	catchAndThrow(env);
+	mTable = JObject(table);
+	env->DeleteLocalRef(table);
+}
+
+
+/**
+ * Adds an object to the table.
+ */
+HandleTable::Handle HandleTable::add(const JObject& object)
+{
+	return add(attach(), static_cast<jobject>(object));
+}
+
+
+/**
+ * Adds an object to the table.
+ */
+HandleTable::Handle HandleTable::add(JNIEnv* env, jobject object)
+{
+	if (!object)
+		return 0;
+
+	jmethodID method = getMethods().add;
+	Handle result = env->CallIntMethod(static_cast<jobject>(mTable), method, object);
+	catchAndThrow(env);
+	return result;
+}
+
+
+/**
+ * Adds several objects to the table.
+ */
+void HandleTable::add(JNIEnv* env, const jobject* objects, size_t count, Handle* handles)
+{
+	if (count == 0)
+		return;
+
+	jmethodID method = getMethods().addAll;
+	jsize length = toArrayLength(count);
+
+	LocalFrame frame(env, 2);
+	jclass objectClass = JObject::staticGetJavaJniClass().getClass();
+	jobjectArray array = env->NewObjectArray(length, objectClass, 0);
+	catchAndThrow(env);
+	for (jsize i = 0; i < length; ++i)
+		env->SetObjectArrayElement(array, i, objects[i]);
+
+	jintArray result = static_cast<jintArray>(env->CallObjectMethod(static_cast<jobject>(mTable), method, array,
+		length));
+	catchAndThrow(env);
+	env->GetIntArrayRegion(result, 0, length, handles);
+}
+
+
+/**
+ * Adds several objects to the table.
+ */
+std::vector<HandleTable::Handle> HandleTable::add(JNIEnv* env, const std::vector<jobject>& objects)
+{
+	std::vector<Handle> handles(objects.size());
+	if (!objects.empty())
+		add(env, &objects[0], objects.size(), &handles[0]);
+	return handles;
+}
+
+
+/**
+ * Returns a new local reference to the object of a handle.
+ */
+jobject HandleTable::get(JNIEnv* env, Handle handle) const
+{
+	if (handle == 0)
+		return 0;
+
+	jmethodID method = getMethods().get;
+	jobject result = env->CallObjectMethod(static_cast<jobject>(mTable), method, handle);
+	catchAndThrow(env);
+	return result;
+}
+
+
+/**
+ * Returns new local references to the objects of several handles.
+ */
+void HandleTable::get(JNIEnv* env, const Handle* handles, size_t count, jobject* objects) const
+{
+	if (count == 0)
+		return;
+
+	jmethodID method = getMethods().getAll;
+	jsize length = toArrayLength(count);
+
+	// Room for the results, plus the two arrays
+	ensureLocalCapacity(env, length + 2);
+	jintArray array = env->NewIntArray(length);
+	catchAndThrow(env);
+	env->SetIntArrayRegion(array, 0, length, handles);
+
+	jobjectArray result = static_cast<jobjectArray>(env->CallObjectMethod(static_cast<jobject>(mTable), method,
+		array, length));
+	env->DeleteLocalRef(array);
+	catchAndThrow(env);
+	for (jsize i = 0; i < length; ++i)
+		objects[i] = env->GetObjectArrayElement(result, i);
+	env->DeleteLocalRef(result);
+}
+
+
+/**
+ * Removes the object of a handle from the table.
+ */
+void HandleTable::remove(Handle handle)
+{
+	remove(attach(), handle);
+}
+
+
+/**
+ * Removes the object of a handle from the table.
+ */
+void HandleTable::remove(JNIEnv* env, Handle handle)
+{
+	if (handle == 0)
+		return;
+
+	jmethodID method = getMethods().remove;
+	env->CallVoidMethod(static_cast<jobject>(mTable), method, handle);
+	catchAndThrow(env);
+}
+
+
+/**
+ * Removes the objects of several handles from the table.
+ */
+void HandleTable::remove(JNIEnv* env, const Handle* handles, size_t count)
+{
+	if (count == 0)
+		return;
+
+	jmethodID method = getMethods().removeAll;
+	jsize length = toArrayLength(count);
+
+	LocalFrame frame(env, 1);
+	jintArray array = env->NewIntArray(length);
+	catchAndThrow(env);
+	env->SetIntArrayRegion(array, 0, length, handles);
+	env->CallVoidMethod(static_cast<jobject>(mTable), method, array, length);
+	catchAndThrow(env);
+}
+
+
+/**
+ * Removes the objects of several handles from the table.
+ */
+void HandleTable::remove(JNIEnv* env, const std::vector<Handle>& handles)
+{
+	if (!handles.empty())
+		remove(env, &handles[0], handles.size());
+}
+
+
+/**
+ * Removes every object from the table.
+ */
+void HandleTable::clear()
+{
+	JNIEnv* env = attach();
+	jmethodID method = getMethods().clear;
+	env->CallVoidMethod(static_cast<jobject>(mTable), method);
+	catchAndThrow(env);
+}
+
+
+/**
+ * Returns the number of objects in the table.
+ */
+jint HandleTable::size() const
+{
+	JNIEnv* env = attach();
+	jmethodID method = getMethods().size;
+	jint result = env->CallIntMethod(static_cast<jobject>(mTable), method);
+	catchAndThrow(env);
+	return result;
+}
+
+
+/**
+ * Returns the java table.
+ */
+const JObject& HandleTable::getTable() const
+{
+	return mTable;
+}
+
+END_NAMESPACE(jace)
@@ -7,13 +7,16 @@ using jace::proxy::JValue;
 #include <list>
 using std::list;
 
+#include <vector>
+using std::vector;
+
 
 BEGIN_NAMESPACE(jace)
 
 /**
  * Constructs a new argument list. 
  */
-JArguments::JArguments(): mList()
+JArguments::JArguments(): mOverflow(), mSize(0)
 {
 }
 
@@ -25,7 +28,16 @@ JArguments::JArguments(): mList()
  */
 JArguments& JArguments::add(const JValue& value)
 {
-  mList.push_back(&value);
+  if (mSize < InlineCapacity)
+    mInline[mSize] = &value;
+  else
+  {
+    // Move everything to the heap once we run out of inline storage
+    if (mOverflow.empty())
+      mOverflow.assign(mInline, mInline + InlineCapacity);
+    mOverflow.push_back(&value);
+  }
+  ++mSize;
   return *this;
 }
 
@@ -55,13 +67,61 @@ JArguments& JArguments::operator<<(const JValue& value)
 }
 
 
+/**
+ * Returns the number of arguments.
+ */
+size_t JArguments::size() const
+{
+  return mSize;
+}
+
+
+/**
+ * Returns the arguments, in order, as a contiguous array of size() JValue*'s.
+ */
+const JValue* const* JArguments::values() const
+{
+  return mSize <= InlineCapacity ? mInline : &mOverflow[0];
+}
+
+
 /**
  * Returns this JArguments as a list of JValue*'s.
  *
  */
 list<const JValue*> JArguments::asList() const
 {
-  return mList;
+  const JValue* const* begin = values();
+  return list<const JValue*>(begin, begin + mSize);
+}
+
+
+/**
+ * Converts the given arguments to jvalues.
+ */
+JArgumentValues::JArgumentValues(const JArguments& arguments): mOverflow(), mValues(mInline)
+{
+  size_t size = arguments.size();
+  jvalue* target = mInline;
+  if (size > JArguments::InlineCapacity)
+  {
+    mOverflow.resize(size);
+    target = &mOverflow[0];
+    mValues = target;
+  }
+
+  const JValue* const* values = arguments.values();
+  for (size_t i = 0; i < size; ++i)
+    target[i] = static_cast<jvalue>(*values[i]);
+}
+
+
+/**
+ * Returns the jvalues. The result is never null, even if there are no arguments.
+ */
+jvalue* JArgumentValues::get()
+{
+  return mValues;
 }
 
 END_NAMESPACE(jace)
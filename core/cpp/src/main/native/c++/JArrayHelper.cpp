@@ -1,5 +1,7 @@
 #include "jace/JArrayHelper.h"
 
+#include "jace/RefTracker.h"
+
 using jace::JClass;
 using jace::proxy::types::JInt;
 
@@ -29,9 +31,62 @@ jvalue getElement(jobject obj, int index)
 {
   jobjectArray thisArray = static_cast<jobjectArray>(obj);
   jobject object = attach()->GetObjectArrayElement(thisArray, index);
+  JACE_REF_CREATED(Local, object, "JArrayHelper::getElement");
   jvalue value;
   value.l = object;
   return value;
 }
 
+
+JInt getLength(JNIEnv* env, jobject obj)
+{
+  jarray array = static_cast<jarray>(obj);
+  return JInt(env->GetArrayLength(array));
+}
+
+// Returns a local ref for ObjectKind
+jvalue getElement(JNIEnv* env, JTypeKind kind, jobject obj, int index)
+{
+  jvalue value;
+  value.j = 0;
+
+  switch (kind)
+  {
+    case ObjectKind:
+      value.l = env->GetObjectArrayElement(static_cast<jobjectArray>(obj), index);
+      JACE_REF_CREATED(Local, value.l, "JArrayHelper::getElement");
+      break;
+    case BooleanKind:
+      env->GetBooleanArrayRegion(static_cast<jbooleanArray>(obj), index, 1, &value.z);
+      break;
+    case ByteKind:
+      env->GetByteArrayRegion(static_cast<jbyteArray>(obj), index, 1, &value.b);
+      break;
+    case CharKind:
+      env->GetCharArrayRegion(static_cast<jcharArray>(obj), index, 1, &value.c);
+      break;
+    case ShortKind:
+      env->GetShortArrayRegion(static_cast<jshortArray>(obj), index, 1, &value.s);
+      break;
+    case IntKind:
+      env->GetIntArrayRegion(static_cast<jintArray>(obj), index, 1, &value.i);
+      break;
+    case LongKind:
+      env->GetLongArrayRegion(static_cast<jlongArray>(obj), index, 1, &value.j);
+      break;
+    case FloatKind:
+      env->GetFloatArrayRegion(static_cast<jfloatArray>(obj), index, 1, &value.f);
+      break;
+    case DoubleKind:
+      env->GetDoubleArrayRegion(static_cast<jdoubleArray>(obj), index, 1, &value.d);
+      break;
+    case VoidKind:
+      THROW_JNI_EXCEPTION("JArrayHelper::getElement: An array may not have elements of type void.");
+  }
+
+  // An out of bounds index leaves an ArrayIndexOutOfBoundsException pending.
+  catchAndThrow(env);
+  return value;
+}
+
 END_NAMESPACE_2(jace, JArrayHelper)
@@ -0,0 +1,146 @@
+#include "jace/JCompletionStage.h"
+
+#include "jace/Jace.h"
+#include "jace/JNIException.h"
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+
+#include "jace/runtime/NativeProxy.h"
+namespace NativeProxy = jace::runtime::NativeProxy;
+
+#include "jace/proxy/JObject.h"
+using jace::proxy::JObject;
+
+#include <string>
+using std::string;
+
+#include <boost/thread/mutex.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	/**
+	 * Returns the cause of a java.util.concurrent.CompletionException, which is what
+	 * whenComplete() reports for stages that depend on the stage that failed.
+	 * Any other throwable is returned as is.
+	 */
+	jthrowable unwrap(JNIEnv* env, jthrowable error)
+	{
+		jclass completionException = env->FindClass("java/util/concurrent/CompletionException");
+		if (!completionException)
+		{
+			env->ExceptionClear();
+			return error;
+		}
+
+		bool wrapped = env->IsInstanceOf(error, completionException) == JNI_TRUE;
+		env->DeleteLocalRef(completionException);
+		if (!wrapped)
+			return error;
+
+		jclass throwableClass = env->FindClass("java/lang/Throwable");
+		if (!throwableClass)
+		{
+			env->ExceptionClear();
+			return error;
+		}
+		jmethodID getCause = JMemberRegistry::getMethodID(throwableClass, "java/lang/Throwable", "getCause",
+			"()Ljava/lang/Throwable;");
+		env->DeleteLocalRef(throwableClass);
+		if (!getCause)
+		{
+			env->ExceptionClear();
+			return error;
+		}
+
+		jthrowable cause = static_cast<jthrowable>(env->CallObjectMethod(error, getCause));
+		if (env->ExceptionCheck())
+		{
+			env->ExceptionClear();
+			return error;
+		}
+		if (!cause)
+			return error;
+
+		env->DeleteLocalRef(error);
+		return cause;
+	}
+
+	/**
+	 * Implements BiConsumer.accept(result, error), for the proxies passed to whenComplete().
+	 * The context of the proxy is the JCompletionListener.
+	 */
+	jobject accept(JNIEnv* env, JACE_NATIVE_CALLBACK_ARGS)
+	{
+		// The proxy itself is not needed, only its context
+		(void) obj;
+		JCompletionListener* listener = reinterpret_cast<JCompletionListener*>(NativeProxy::getContext());
+		jobjectArray arguments = static_cast<jobjectArray>(static_cast<jobject>(args));
+
+		jobject result = env->GetObjectArrayElement(arguments, 0);
+		jthrowable error = static_cast<jthrowable>(env->GetObjectArrayElement(arguments, 1));
+		if (error)
+			error = unwrap(env, error);
+
+		listener->onComplete(env, result, error);
+
+		if (result)
+			env->DeleteLocalRef(result);
+		if (error)
+			env->DeleteLocalRef(error);
+		return 0;
+	}
+
+	/**
+	 * Returns the Builder of the BiConsumer proxies passed to whenComplete().
+	 *
+	 * The Builder is shared by every proxy, and never deleted, because java may call
+	 * a proxy at any time until it is garbage collected.
+	 */
+	NativeProxy::Builder& getBuilder()
+	{
+		static boost::mutex mutex;
+		static NativeProxy::Builder* builder = 0;
+
+		boost::mutex::scoped_lock lock(mutex);
+		if (!builder)
+		{
+			NativeProxy::Builder* newBuilder = new NativeProxy::Builder("java.util.function.BiConsumer");
+			newBuilder->registerCallback("accept", NativeProxy::Callback(&accept));
+			builder = newBuilder;
+		}
+		return *builder;
+	}
+} // namespace
+
+
+/**
+ * Registers a listener for the completion of a java.util.concurrent.CompletionStage.
+ */
+void whenComplete(const JObject& stage, JCompletionListener* listener)
+{
+	if (stage.isNull())
+		throw JNIException("[jace::whenComplete] Can not wait for a null CompletionStage.");
+
+	JObject consumer = getBuilder().build<JObject>(reinterpret_cast<jlong>(listener));
+
+	JNIEnv* env = attach();
+	jclass stageClass = env->FindClass("java/util/concurrent/CompletionStage");
+	if (!stageClass)
+		THROW_JNI_EXCEPTION("Assert failed: Unable to find the class, java.util.concurrent.CompletionStage.");
+
+	jmethodID method = JMemberRegistry::getMethodID(stageClass, "java/util/concurrent/CompletionStage",
+		"whenComplete", "(Ljava/util/function/BiConsumer;)Ljava/util/concurrent/CompletionStage;");
+	env->DeleteLocalRef(stageClass);
+	if (!method)
+		THROW_JNI_EXCEPTION("Assert failed: Unable to find the method, CompletionStage.whenComplete().");
+
+	// The stage returned by whenComplete() is not needed, the listener already sees the outcome
+	jobject dependent = env->CallObjectMethod(static_cast<jobject>(stage), method, static_cast<jobject>(consumer));
+	catchAndThrow(env);
+	if (dependent)
+		env->DeleteLocalRef(dependent);
+}
+
+END_NAMESPACE(jace)
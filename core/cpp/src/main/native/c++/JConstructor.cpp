@@ -4,19 +4,20 @@
 
 #include "jace/JArguments.h"
 using jace::JArguments;
+using jace::JArgumentValues;
 
 #include "jace/JSignature.h"
 using jace::JSignature;
 
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+
 #include "jace/proxy/types/JVoid.h"
 using jace::proxy::types::JVoid;
 
 #include "jace/proxy/JValue.h"
 using jace::proxy::JValue;
 
-#include <vector>
-using std::vector;
-
 #include <string>
 using std::string;
 
@@ -24,36 +25,30 @@ using std::string;
 using std::cout;
 using std::endl;
 
-#include <list>
-using std::list;
-
 BEGIN_NAMESPACE(jace)
 
-namespace
-{
-	// Transforms a JArguments to a vector of jvalue's
-	vector<jvalue> toVector(const JArguments& arguments)
-	{
-		typedef list<const JValue*> ValueList;
-		vector<jvalue> argsVector;
-		ValueList argsList = arguments.asList();
-
-		ValueList::iterator end = argsList.end();
-
-		for (ValueList::iterator i = argsList.begin(); i != end; ++i)
-			argsVector.push_back(static_cast<jvalue>(**i));
+/**
+ * Creates a new JConstructor for the given JClass.
+ */
+JConstructor::JConstructor(const JClass& javaClass):
+  mClass(javaClass), mSignature(), mMethodID(0)
+{}
 
-		return argsVector;
-	}
 
-} // namespace {
+/**
+ * Creates a new JConstructor for the given JClass, using the constructor
+ * with the given JNI signature.
+ */
+JConstructor::JConstructor(const JClass& javaClass, const string& signature):
+  mClass(javaClass), mSignature(signature), mMethodID(0)
+{}
 
 
 /**
- * Creates a new JConstructor for the given JClass.
+ * Creates a copy of an existing JConstructor, including its cached jmethodID.
  */
-JConstructor::JConstructor(const JClass& javaClass):
-  mClass(javaClass), mMethodID(0)
+JConstructor::JConstructor(const JConstructor& other):
+  mClass(other.mClass), mSignature(other.mSignature), mMethodID(other.mMethodID.load(boost::memory_order_acquire))
 {}
 
 
@@ -65,10 +60,104 @@ JConstructor::JConstructor(const JClass& javaClass):
  * @throws a matching C++ proxy, if a java exception is thrown by the constructor.
  */
 jobject JConstructor::invoke(const JArguments& arguments)
+{
+  JArgumentValues argArray(arguments);
+  return construct(arguments.values(), argArray.get(), arguments.size());
+}
+
+
+/**
+ * Invokes the constructor with the given arguments.
+ * Allocates a new local reference.
+ *
+ * @throws JNIException if an error occurs while trying to invoke the constructor.
+ * @throws a matching C++ proxy, if a java exception is thrown by the constructor.
+ */
+jobject JConstructor::invoke()
+{
+  jvalue arguments[1];
+  return construct(0, arguments, 0);
+}
+
+jobject JConstructor::invoke(const JValue& a0)
+{
+  const JValue* values[] = { &a0 };
+  jvalue arguments[] = { a0 };
+  return construct(values, arguments, 1);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1)
+{
+  const JValue* values[] = { &a0, &a1 };
+  jvalue arguments[] = { a0, a1 };
+  return construct(values, arguments, 2);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2)
+{
+  const JValue* values[] = { &a0, &a1, &a2 };
+  jvalue arguments[] = { a0, a1, a2 };
+  return construct(values, arguments, 3);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3 };
+  jvalue arguments[] = { a0, a1, a2, a3 };
+  return construct(values, arguments, 4);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3, const JValue& a4)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+  jvalue arguments[] = { a0, a1, a2, a3, a4 };
+  return construct(values, arguments, 5);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3, const JValue& a4, const JValue& a5)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+  jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+  return construct(values, arguments, 6);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3, const JValue& a4, const JValue& a5, const JValue& a6)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+  jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+  return construct(values, arguments, 7);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3, const JValue& a4, const JValue& a5, const JValue& a6, const JValue& a7)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+  jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+  return construct(values, arguments, 8);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3, const JValue& a4, const JValue& a5, const JValue& a6, const JValue& a7, const JValue& a8)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+  jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+  return construct(values, arguments, 9);
+}
+
+jobject JConstructor::invoke(const JValue& a0, const JValue& a1, const JValue& a2, const JValue& a3, const JValue& a4, const JValue& a5, const JValue& a6, const JValue& a7, const JValue& a8, const JValue& a9)
+{
+  const JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+  jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+  return construct(values, arguments, 10);
+}
+
+
+/**
+ * Invokes the constructor with arguments that have already been converted to jvalues.
+ */
+jobject JConstructor::construct(const JValue* const* values, jvalue* arguments, size_t count)
 {
   // Get the methodID for the constructor matching the given arguments.
 //  cout << "JConstructor::invoke - Retrieving the methodID..." << endl;
-  jmethodID methodID = getMethodID(mClass, arguments);
+  jmethodID methodID = getMethodID(values, count);
 //  cout << "JConstructor::invoke - Retrieved the methodID." << endl;
 
   // Call the constructor
@@ -77,19 +166,13 @@ jobject JConstructor::invoke(const JArguments& arguments)
 //  cout << "JConstructor::invoke - Attached." << endl;
 
 //  cout << "JConstructor::invoke - Creating the object..." << endl;
-  jobject result;
-	vector<jvalue> argArray = toVector(arguments);
-
-	if (argArray.size() > 0)
-		result = env->NewObjectA(mClass.getClass(), methodID, &argArray[0]);
-	else
-		result = env->NewObject(mClass.getClass(), methodID);
+  jobject result = env->NewObjectA(mClass.getClass(), methodID, arguments);
 //  cout << "JConstructor::invoke - Created the object..." << endl;
 
   // Catch any java exception that occurred during the method call,
   // and throw it as a C++ exception.
 //  cout << "JConstructor::invoke - Checking for exceptions..." << endl;
-  catchAndThrow();
+  catchAndThrow(env);
 //  cout << "JConstructor::invoke - Found no exceptions." << endl;
 
   return result;
@@ -99,47 +182,40 @@ jobject JConstructor::invoke(const JArguments& arguments)
 /**
  * Gets the method id matching the given arguments.
  */
-jmethodID JConstructor::getMethodID(const JClass& jClass, const JArguments& arguments)
+jmethodID JConstructor::getMethodID(const JValue* const* values, size_t count)
 {
   // We cache the jmethodID locally, so if we've already found it,
   // we don't need to go looking for it again.
-  if (mMethodID)
-    return mMethodID;
+  jmethodID methodID = mMethodID.load(boost::memory_order_acquire);
+  if (methodID)
+    return methodID;
 
   // If we don't already have the jmethodID, we need to determine
-  // the signature of this method.
-
-  // We construct this signature with a void return type,
-  // because the return type for constructors is void.
-  JSignature signature(JVoid::staticGetJavaJniClass());
-  typedef list<const JValue*> ValueList;
-  ValueList args = arguments.asList();
-
-  ValueList::iterator i = args.begin();
-  ValueList::iterator end = args.end();
-
-  for (; i != end; ++i)
-	{
-    const JValue* value = *i;
-    signature << value->getJavaJniClass();
+  // the signature of this method, unless we were given one.
+  string methodSignature = mSignature;
+  if (methodSignature.empty())
+  {
+    // We construct this signature with a void return type,
+    // because the return type for constructors is void.
+    JSignature signature(JVoid::staticGetJavaJniClass());
+    for (size_t i = 0; i < count; ++i)
+      signature << values[i]->getJavaJniClass();
+
+    methodSignature = signature.toString();
   }
 
-  string methodSignature = signature.toString();
-
-  // Now that we have the signature for the method, we could look
-  // in a global cache for the jmethodID corresponding to this method,
-  // but for now, we'll always find it.
-  JNIEnv* env = attach();
-
-  mMethodID = env->GetMethodID(jClass.getClass(), "<init>", methodSignature.c_str());
+  // Now that we have the signature for the method, look it up
+  // in the global cache for the jmethodID corresponding to this method.
+  methodID = JMemberRegistry::getMethodID(mClass, "<init>", methodSignature);
 
-  if (mMethodID == 0) {
+  if (methodID == 0) {
       THROW_JNI_EXCEPTION(string("JConstructor::getMethodID(): ") +
-                                 "Unable to find constructor for " + jClass.getInternalName() + 
+                                 "Unable to find constructor for " + mClass.getInternalName() + 
 				                 " with signature " + methodSignature);
   }
 
-  return mMethodID;
+  mMethodID.store(methodID, boost::memory_order_release);
+  return methodID;
 }
 
 
@@ -1,6 +1,7 @@
 
 #include "jace/JFieldHelper.h"
 #include "jace/Jace.h"
+#include "jace/JMemberRegistry.h"
 
 using jace::proxy::JObject;
 using jace::JClass;
@@ -17,33 +18,127 @@ JFieldHelper::JFieldHelper(const std::string& name, const JClass& typeClass):
 
 
 jvalue JFieldHelper::getField(JObject& object)
+{
+  return getField(object, ObjectKind);
+}
+
+
+jvalue JFieldHelper::getField(const JClass& jClass)
+{
+  return getField(jClass, ObjectKind);
+}
+
+
+jvalue JFieldHelper::getField(JObject& object, JTypeKind kind)
+{
+  return getField(attach(), object, kind);
+}
+
+
+jvalue JFieldHelper::getField(const JClass& jClass, JTypeKind kind)
+{
+  return getField(attach(), jClass, kind);
+}
+
+
+jvalue JFieldHelper::getField(JNIEnv* env, JObject& object, JTypeKind kind)
 {
   // Get the fieldID for the field belonging to the given object.
   const JClass& parentClass = object.getJavaJniClass();
   jfieldID fieldID = getFieldID(parentClass, false);
 
   // Get the field value.
-  JNIEnv* env = attach();
-  jobject result = env->GetObjectField(static_cast<jobject>(object), fieldID);
-
+  jobject instance = static_cast<jobject>(object);
   jvalue value;
-  value.l = result;
+  value.j = 0;
+
+  switch (kind)
+  {
+    case ObjectKind:
+      value.l = env->GetObjectField(instance, fieldID);
+      break;
+    case BooleanKind:
+      value.z = env->GetBooleanField(instance, fieldID);
+      break;
+    case ByteKind:
+      value.b = env->GetByteField(instance, fieldID);
+      break;
+    case CharKind:
+      value.c = env->GetCharField(instance, fieldID);
+      break;
+    case ShortKind:
+      value.s = env->GetShortField(instance, fieldID);
+      break;
+    case IntKind:
+      value.i = env->GetIntField(instance, fieldID);
+      break;
+    case LongKind:
+      value.j = env->GetLongField(instance, fieldID);
+      break;
+    case FloatKind:
+      value.f = env->GetFloatField(instance, fieldID);
+      break;
+    case DoubleKind:
+      value.d = env->GetDoubleField(instance, fieldID);
+      break;
+    case VoidKind:
+      THROW_JNI_EXCEPTION("JFieldHelper::getField: A field may not be of type void.");
+  }
+
+  // Catch any java exception that occured while reading the field,
+  // and throw it as a C++ exception.
+  catchAndThrow(env);
 
   return value;
 }
 
 
-jvalue JFieldHelper::getField(const JClass& jClass)
+jvalue JFieldHelper::getField(JNIEnv* env, const JClass& jClass, JTypeKind kind)
 {
   // Get the fieldID for the field belonging to the given class.
   jfieldID fieldID = getFieldID(jClass, true);
 
   // Get the field value.
-  JNIEnv* env = attach();
-  jobject result = env->GetStaticObjectField(jClass.getClass(), fieldID);
-
+  jclass parentClass = jClass.getClass();
   jvalue value;
-  value.l = result;
+  value.j = 0;
+
+  switch (kind)
+  {
+    case ObjectKind:
+      value.l = env->GetStaticObjectField(parentClass, fieldID);
+      break;
+    case BooleanKind:
+      value.z = env->GetStaticBooleanField(parentClass, fieldID);
+      break;
+    case ByteKind:
+      value.b = env->GetStaticByteField(parentClass, fieldID);
+      break;
+    case CharKind:
+      value.c = env->GetStaticCharField(parentClass, fieldID);
+      break;
+    case ShortKind:
+      value.s = env->GetStaticShortField(parentClass, fieldID);
+      break;
+    case IntKind:
+      value.i = env->GetStaticIntField(parentClass, fieldID);
+      break;
+    case LongKind:
+      value.j = env->GetStaticLongField(parentClass, fieldID);
+      break;
+    case FloatKind:
+      value.f = env->GetStaticFloatField(parentClass, fieldID);
+      break;
+    case DoubleKind:
+      value.d = env->GetStaticDoubleField(parentClass, fieldID);
+      break;
+    case VoidKind:
+      THROW_JNI_EXCEPTION("JFieldHelper::getField: A field may not be of type void.");
+  }
+
+  // Catch any java exception that occured while reading the field,
+  // and throw it as a C++ exception.
+  catchAndThrow(env);
 
   return value;
 }
@@ -60,16 +155,9 @@ jfieldID JFieldHelper::getFieldID(const JClass& parentClass, bool isStatic)
   if (mFieldID)
     return mFieldID;
 
-  // We could look in a global cache for the jfieldID corresponding to this field,
-  // but for now, we'll always find it.
-  JNIEnv* env = attach();
-
+  // Look in the global cache for the jfieldID corresponding to this field.
   string signature = mTypeClass.getSignature();
-
-  if (isStatic)
-    mFieldID = env->GetStaticFieldID(parentClass.getClass(), mName.c_str(), signature.c_str());
-  else
-    mFieldID = env->GetFieldID(parentClass.getClass(), mName.c_str(), signature.c_str());
+  mFieldID = JMemberRegistry::getFieldID(parentClass, mName, signature, isStatic);
 
   if (mFieldID == 0) {
       THROW_JNI_EXCEPTION(string("JFieldHelper::getFieldID\n") +
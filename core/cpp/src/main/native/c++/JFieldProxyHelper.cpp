@@ -26,5 +26,79 @@ jobject assign(const JObject& field, jclass parentClass, jfieldID fieldID)
   return object;
 }
 
+void assign(JTypeKind kind, jvalue value, jobject parent, jfieldID fieldID)
+{
+  JNIEnv* env = attach();
+  switch (kind)
+  {
+    case ObjectKind:
+      env->SetObjectField(parent, fieldID, value.l);
+      break;
+    case BooleanKind:
+      env->SetBooleanField(parent, fieldID, value.z);
+      break;
+    case ByteKind:
+      env->SetByteField(parent, fieldID, value.b);
+      break;
+    case CharKind:
+      env->SetCharField(parent, fieldID, value.c);
+      break;
+    case ShortKind:
+      env->SetShortField(parent, fieldID, value.s);
+      break;
+    case IntKind:
+      env->SetIntField(parent, fieldID, value.i);
+      break;
+    case LongKind:
+      env->SetLongField(parent, fieldID, value.j);
+      break;
+    case FloatKind:
+      env->SetFloatField(parent, fieldID, value.f);
+      break;
+    case DoubleKind:
+      env->SetDoubleField(parent, fieldID, value.d);
+      break;
+    case VoidKind:
+      THROW_JNI_EXCEPTION("JFieldProxyHelper::assign: A field may not be of type void.");
+  }
+}
+
+void assign(JTypeKind kind, jvalue value, jclass parentClass, jfieldID fieldID)
+{
+  JNIEnv* env = attach();
+  switch (kind)
+  {
+    case ObjectKind:
+      env->SetStaticObjectField(parentClass, fieldID, value.l);
+      break;
+    case BooleanKind:
+      env->SetStaticBooleanField(parentClass, fieldID, value.z);
+      break;
+    case ByteKind:
+      env->SetStaticByteField(parentClass, fieldID, value.b);
+      break;
+    case CharKind:
+      env->SetStaticCharField(parentClass, fieldID, value.c);
+      break;
+    case ShortKind:
+      env->SetStaticShortField(parentClass, fieldID, value.s);
+      break;
+    case IntKind:
+      env->SetStaticIntField(parentClass, fieldID, value.i);
+      break;
+    case LongKind:
+      env->SetStaticLongField(parentClass, fieldID, value.j);
+      break;
+    case FloatKind:
+      env->SetStaticFloatField(parentClass, fieldID, value.f);
+      break;
+    case DoubleKind:
+      env->SetStaticDoubleField(parentClass, fieldID, value.d);
+      break;
+    case VoidKind:
+      THROW_JNI_EXCEPTION("JFieldProxyHelper::assign: A field may not be of type void.");
+  }
+}
+
 
 END_NAMESPACE_2(jace, JFieldProxyHelper)
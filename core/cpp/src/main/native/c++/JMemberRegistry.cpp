@@ -0,0 +1,271 @@
+#include "jace/JMemberRegistry.h"
+
+#include "jace/Jace.h"
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	enum MemberKind { Method, StaticMethod, Field, StaticField };
+
+	/**
+	 * A resolved member. Entries are never modified once they are published.
+	 *
+	 * Classes loaded by different class loaders may share a name, so an entry also holds a weak
+	 * reference to the class it was resolved in, and only matches that class. The reference is
+	 * weak so that the registry does not keep classes from being unloaded.
+	 */
+	struct Entry
+	{
+		Entry(MemberKind _kind, size_t _hash, jobject _classRef, const string& _className, const string& _name,
+			const string& _signature, void* _id):
+			kind(_kind), hash(_hash), classRef(_classRef), className(_className), name(_name), signature(_signature),
+			id(_id)
+		{}
+
+		bool matches(JNIEnv* env, MemberKind _kind, size_t _hash, jclass jClass, const string& _className,
+			const string& _name, const string& _signature) const
+		{
+			return kind == _kind && hash == _hash && name == _name && signature == _signature &&
+				className == _className && env->IsSameObject(classRef, jClass) == JNI_TRUE;
+		}
+
+		const MemberKind kind;
+		const size_t hash;
+		const jobject classRef;
+		const string className;
+		const string name;
+		const string signature;
+		void* const id;
+	};
+
+	/**
+	 * An open-addressing hash table of entries.
+	 *
+	 * Readers probe the slots without locking. Writers hold registryMutex, only ever
+	 * fill empty slots, and replace the whole table when it needs to grow.
+	 */
+	struct Table
+	{
+		explicit Table(size_t _capacity): capacity(_capacity), size(0), slots(new boost::atomic<Entry*>[_capacity])
+		{
+			for (size_t i = 0; i < capacity; ++i)
+				slots[i].store(0, boost::memory_order_relaxed);
+		}
+
+		~Table()
+		{
+			delete[] slots;
+		}
+
+		const size_t capacity;
+		size_t size;
+		boost::atomic<Entry*>* const slots;
+
+	private:
+		Table(const Table&);
+		Table& operator=(const Table&);
+	};
+
+	const size_t initialCapacity = 256;
+
+	boost::atomic<Table*> currentTable(0);
+	boost::atomic<unsigned long> hitCount(0);
+	boost::atomic<unsigned long> missCount(0);
+
+	/**
+	 * Guards the fields below, and all modifications of currentTable.
+	 */
+	boost::mutex registryMutex;
+	typedef boost::unique_lock<boost::mutex> auto_lock;
+
+	// Every entry ever added, and the tables that were replaced while growing.
+	// Readers may still be probing a replaced table, so they are only freed by reset().
+	vector<Entry*> entries;
+	vector<Table*> retiredTables;
+
+	size_t hashOf(MemberKind kind, const string& className, const string& name, const string& signature)
+	{
+		// FNV-1a
+		size_t hash = 2166136261u ^ static_cast<size_t>(kind);
+		const string* parts[] = { &className, &name, &signature };
+		for (size_t i = 0; i < 3; ++i)
+		{
+			const string& part = *parts[i];
+			for (string::const_iterator c = part.begin(); c != part.end(); ++c)
+				hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+			hash = (hash ^ 0xff) * 16777619u;
+		}
+		return hash;
+	}
+
+	Entry* find(JNIEnv* env, const Table* table, MemberKind kind, size_t hash, jclass jClass, const string& className,
+		const string& name, const string& signature)
+	{
+		if (!table)
+			return 0;
+
+		size_t mask = table->capacity - 1;
+		for (size_t i = hash & mask;; i = (i + 1) & mask)
+		{
+			Entry* entry = table->slots[i].load(boost::memory_order_acquire);
+			if (!entry)
+				return 0;
+			if (entry->matches(env, kind, hash, jClass, className, name, signature))
+				return entry;
+		}
+	}
+
+	// Must be called with registryMutex held, and there must be room for the entry.
+	void place(Table* table, Entry* entry)
+	{
+		size_t mask = table->capacity - 1;
+		size_t i = entry->hash & mask;
+		while (table->slots[i].load(boost::memory_order_relaxed))
+			i = (i + 1) & mask;
+		table->slots[i].store(entry, boost::memory_order_release);
+		++table->size;
+	}
+
+	// Must be called with registryMutex held.
+	void insert(Entry* entry)
+	{
+		Table* table = currentTable.load(boost::memory_order_relaxed);
+
+		// Keep the load factor at or below one half, so that probe sequences stay short.
+		if (!table || (table->size + 1) * 2 > table->capacity)
+		{
+			Table* larger = new Table(table ? table->capacity * 2 : initialCapacity);
+			for (vector<Entry*>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+				place(larger, *i);
+
+			currentTable.store(larger, boost::memory_order_release);
+			if (table)
+				retiredTables.push_back(table);
+			table = larger;
+		}
+
+		entries.push_back(entry);
+		place(table, entry);
+	}
+
+	void* lookup(MemberKind kind, jclass jClass, const string& className, const string& name, const string& signature)
+	{
+		size_t hash = hashOf(kind, className, name, signature);
+
+		JNIEnv* env = attach();
+		Entry* entry = find(env, currentTable.load(boost::memory_order_acquire), kind, hash, jClass, className, name,
+			signature);
+		if (entry)
+		{
+			hitCount.fetch_add(1, boost::memory_order_relaxed);
+			return entry->id;
+		}
+
+		missCount.fetch_add(1, boost::memory_order_relaxed);
+
+		// Ask the virtual machine outside of the lock. Concurrent misses of the same member
+		// resolve to the same id, and only the first one is recorded.
+		void* id;
+		switch (kind)
+		{
+			case Method:
+				id = env->GetMethodID(jClass, name.c_str(), signature.c_str());
+				break;
+			case StaticMethod:
+				id = env->GetStaticMethodID(jClass, name.c_str(), signature.c_str());
+				break;
+			case Field:
+				id = env->GetFieldID(jClass, name.c_str(), signature.c_str());
+				break;
+			default:
+				id = env->GetStaticFieldID(jClass, name.c_str(), signature.c_str());
+				break;
+		}
+
+		// Failures are not cached, the caller reports them.
+		if (!id)
+			return 0;
+
+		auto_lock lock(registryMutex);
+		if (!find(env, currentTable.load(boost::memory_order_relaxed), kind, hash, jClass, className, name, signature))
+			insert(new Entry(kind, hash, newWeakGlobalRef(env, jClass), className, name, signature, id));
+		return id;
+	}
+
+} // namespace
+
+
+jmethodID JMemberRegistry::getMethodID(const JClass& jClass, const string& name, const string& signature,
+	bool isStatic)
+{
+	return static_cast<jmethodID>(lookup(isStatic ? StaticMethod : Method, jClass.getClass(),
+		jClass.getInternalName(), name, signature));
+}
+
+
+jmethodID JMemberRegistry::getMethodID(jclass jClass, const string& className, const string& name,
+	const string& signature, bool isStatic)
+{
+	return static_cast<jmethodID>(lookup(isStatic ? StaticMethod : Method, jClass, className, name, signature));
+}
+
+
+jfieldID JMemberRegistry::getFieldID(const JClass& jClass, const string& name, const string& signature,
+	bool isStatic)
+{
+	return static_cast<jfieldID>(lookup(isStatic ? StaticField : Field, jClass.getClass(),
+		jClass.getInternalName(), name, signature));
+}
+
+
+unsigned long JMemberRegistry::hits()
+{
+	return hitCount.load(boost::memory_order_relaxed);
+}
+
+
+unsigned long JMemberRegistry::misses()
+{
+	return missCount.load(boost::memory_order_relaxed);
+}
+
+
+size_t JMemberRegistry::size()
+{
+	auto_lock lock(registryMutex);
+	return entries.size();
+}
+
+
+void JMemberRegistry::reset()
+{
+	auto_lock lock(registryMutex);
+
+	Table* table = currentTable.exchange(0, boost::memory_order_acq_rel);
+	delete table;
+
+	for (vector<Table*>::iterator i = retiredTables.begin(); i != retiredTables.end(); ++i)
+		delete *i;
+	retiredTables.clear();
+
+	// The weak class references went away with the virtual machine, so they are not deleted
+	for (vector<Entry*>::iterator i = entries.begin(); i != entries.end(); ++i)
+		delete *i;
+	entries.clear();
+
+	hitCount.store(0, boost::memory_order_relaxed);
+	missCount.store(0, boost::memory_order_relaxed);
+}
+
+
+END_NAMESPACE(jace)
@@ -6,8 +6,7 @@ using jace::JArguments;
 #include "jace/proxy/JValue.h"
 using jace::proxy::JValue;
 
-#include <list>
-using std::list;
+#include "jace/Jace.h"
 
 #include <vector>
 using std::vector;
@@ -20,15 +19,72 @@ BEGIN_NAMESPACE(jace)
  */
 vector<jvalue> toVector(const JArguments& arguments)
 {
-  typedef list<const JValue*> ValueList;
-  vector<jvalue> argsVector;
-  ValueList argsList = arguments.asList();
+  JArgumentValues values(arguments);
+  return vector<jvalue>(values.get(), values.get() + arguments.size());
+}
+
+
+/**
+ * Attaches the current thread, and pushes the local frame of the batch.
+ */
+// The result of every call is released before the next one, so the frame only needs a few references.
+JMethodBatch::JMethodBatch(ExceptionMode mode): mEnv(attach()), mFrame(mEnv, 16), mMode(mode), mFirstException(0)
+{}
+
+
+/**
+ * Pops the local frame of the batch, through mFrame.
+ *
+ * This also releases the first exception of the batch, if it was never thrown.
+ */
+JMethodBatch::~JMethodBatch()
+{}
+
+
+/**
+ * Returns the JNIEnv of the current thread.
+ */
+JNIEnv* JMethodBatch::getEnv() const
+{
+  return mEnv;
+}
+
+
+/**
+ * Checks for a java exception after a call of the batch.
+ */
+void JMethodBatch::check()
+{
+  if (!mEnv->ExceptionCheck())
+    return;
+
+  if (mMode == StopOnException)
+    catchAndThrow();
 
-  ValueList::iterator end = argsList.end();
-  for (ValueList::iterator i = argsList.begin(); i != end; ++i)
-    argsVector.push_back(static_cast<jvalue>(**i));
+  // No JNI calls are allowed while an exception is pending, so we clear it until the batch is complete.
+  jthrowable exception = mEnv->ExceptionOccurred();
+  mEnv->ExceptionClear();
+
+  if (mFirstException)
+    mEnv->DeleteLocalRef(exception);
+  else
+    mFirstException = exception;
+}
+
+
+/**
+ * Rethrows the first java exception of the batch, if any.
+ */
+void JMethodBatch::finish()
+{
+  if (!mFirstException)
+    return;
 
-  return argsVector;
+  jthrowable exception = mFirstException;
+  mFirstException = 0;
+  mEnv->Throw(exception);
+  mEnv->DeleteLocalRef(exception);
+  catchAndThrow();
 }
 
 END_NAMESPACE(jace)
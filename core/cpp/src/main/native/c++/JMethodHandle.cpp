@@ -0,0 +1,143 @@
+#include "jace/JMethodHandle.h"
+
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+
+#include <string>
+using std::string;
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	boost::shared_ptr<_jclass> newClassRef(jclass jClass)
+	{
+		jclass globalRef = static_cast<jclass>(newGlobalRef(jClass));
+		return boost::shared_ptr<_jclass>(globalRef, static_cast<void (*)(jobject)>(&deleteGlobalRef));
+	}
+
+	void checkMethodID(jmethodID methodID, const string& name, const string& signature)
+	{
+		if (!methodID)
+		{
+			THROW_JNI_EXCEPTION(string("JMethodHandle: Unable to find method <") + name +
+				"> with signature <" + signature + ">");
+		}
+	}
+
+	/**
+	 * Appends the kind of the type at position of a descriptor to kinds: its letter for a primitive
+	 * type or void, and 'L' for any class or array.
+	 *
+	 * @return the position past the type, or string::npos if the descriptor is malformed
+	 */
+	string::size_type parseKind(const string& descriptor, string::size_type position, string& kinds)
+	{
+		string::size_type start = position;
+		while (position < descriptor.size() && descriptor[position] == '[')
+			++position;
+		if (position >= descriptor.size())
+			return string::npos;
+
+		char kind = descriptor[position];
+		if (kind == 'L')
+		{
+			position = descriptor.find(';', position);
+			if (position == string::npos)
+				return string::npos;
+		}
+		else if (string("ZBCSIJFDV").find(kind) == string::npos)
+			return string::npos;
+
+		kinds += (position > start || kind == 'L') ? 'L' : kind;
+		return position + 1;
+	}
+
+	/**
+	 * Returns the kinds of the arguments and result of a method descriptor, such as "IL)V" for
+	 * "(ILjava/lang/String;)V", or an empty string if the descriptor is malformed.
+	 */
+	string getKinds(const string& descriptor)
+	{
+		string kinds;
+		if (descriptor.empty() || descriptor[0] != '(')
+			return string();
+
+		string::size_type position = 1;
+		while (position < descriptor.size() && descriptor[position] != ')')
+		{
+			position = parseKind(descriptor, position, kinds);
+			if (position == string::npos)
+				return string();
+		}
+		if (position >= descriptor.size())
+			return string();
+		kinds += ')';
+
+		position = parseKind(descriptor, position + 1, kinds);
+		if (position != descriptor.size())
+			return string();
+		return kinds;
+	}
+} // namespace
+
+
+/**
+ * Resolves the method with the given name and signature in jClass.
+ */
+JMethodHandleBase::JMethodHandleBase(jclass jClass, const string& name, const string& signature, Kind kind):
+	mClass(newClassRef(jClass)), mMethodID(0)
+{
+	JNIEnv* env = attach();
+	if (kind == Static)
+		mMethodID = env->GetStaticMethodID(jClass, name.c_str(), signature.c_str());
+	else
+		mMethodID = env->GetMethodID(jClass, name.c_str(), signature.c_str());
+	checkMethodID(mMethodID, name, signature);
+}
+
+
+/**
+ * Resolves the method with the given name and signature in jClass, through JMemberRegistry.
+ */
+JMethodHandleBase::JMethodHandleBase(const JClass& jClass, const string& name, const string& signature, Kind kind):
+	mClass(newClassRef(jClass.getClass())),
+	mMethodID(JMemberRegistry::getMethodID(jClass, name, signature, kind == Static))
+{
+	checkMethodID(mMethodID, name, signature);
+}
+
+
+/**
+ * Returns descriptor, once it is checked against the signature computed from the proxy types of a handle.
+ */
+const string& JMethodHandleBase::checkDescriptor(const string& descriptor, const string& expected)
+{
+	string kinds = getKinds(descriptor);
+	if (kinds.empty() || kinds != getKinds(expected))
+	{
+		THROW_JNI_EXCEPTION(string("JMethodHandle: The descriptor <") + descriptor +
+			"> does not match the signature <" + expected + ">");
+	}
+	return descriptor;
+}
+
+
+/**
+ * Returns the class the method belongs to.
+ */
+jclass JMethodHandleBase::getClass() const
+{
+	return mClass.get();
+}
+
+
+/**
+ * Returns the resolved method.
+ */
+jmethodID JMethodHandleBase::getMethodID() const
+{
+	return mMethodID;
+}
+
+END_NAMESPACE(jace)
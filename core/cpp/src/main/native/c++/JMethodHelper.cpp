@@ -0,0 +1,240 @@
+#include "jace/JMethodHelper.h"
+
+#include "jace/Jace.h"
+#include "jace/JNIException.h"
+#include "jace/JSignature.h"
+#include "jace/JMemberRegistry.h"
+
+#include "jace/proxy/JObject.h"
+using jace::proxy::JObject;
+
+#include "jace/proxy/JValue.h"
+using jace::proxy::JValue;
+
+#include <string>
+using std::string;
+
+BEGIN_NAMESPACE(jace)
+
+/**
+ * Creates a new JMethodHelper for the method with the given name.
+ */
+JMethodHelper::JMethodHelper(const string& name, const JClass* declaringClass, const string& signature):
+  mName(name), mClass(declaringClass), mSignature(signature), mMethodID(0)
+{}
+
+
+/**
+ * Creates a copy of an existing JMethodHelper, including its cached jmethodID.
+ */
+JMethodHelper::JMethodHelper(const JMethodHelper& other):
+  mName(other.mName), mClass(other.mClass), mSignature(other.mSignature),
+  mMethodID(other.mMethodID.load(boost::memory_order_acquire))
+{}
+
+
+/**
+ * Calls a method, through the Call<Type>MethodA function matching kind.
+ */
+jvalue JMethodHelper::call(JNIEnv* env, JTypeKind kind, jobject object, jmethodID methodID, jvalue* arguments)
+{
+  jvalue result;
+  result.j = 0;
+
+  switch (kind)
+  {
+    case ObjectKind:
+      result.l = env->CallObjectMethodA(object, methodID, arguments);
+      break;
+    case BooleanKind:
+      result.z = env->CallBooleanMethodA(object, methodID, arguments);
+      break;
+    case ByteKind:
+      result.b = env->CallByteMethodA(object, methodID, arguments);
+      break;
+    case CharKind:
+      result.c = env->CallCharMethodA(object, methodID, arguments);
+      break;
+    case ShortKind:
+      result.s = env->CallShortMethodA(object, methodID, arguments);
+      break;
+    case IntKind:
+      result.i = env->CallIntMethodA(object, methodID, arguments);
+      break;
+    case LongKind:
+      result.j = env->CallLongMethodA(object, methodID, arguments);
+      break;
+    case FloatKind:
+      result.f = env->CallFloatMethodA(object, methodID, arguments);
+      break;
+    case DoubleKind:
+      result.d = env->CallDoubleMethodA(object, methodID, arguments);
+      break;
+    case VoidKind:
+      env->CallVoidMethodA(object, methodID, arguments);
+      break;
+  }
+  return result;
+}
+
+
+/**
+ * Calls a static method, through the CallStatic<Type>MethodA function matching kind.
+ */
+jvalue JMethodHelper::callStatic(JNIEnv* env, JTypeKind kind, jclass jClass, jmethodID methodID, jvalue* arguments)
+{
+  jvalue result;
+  result.j = 0;
+
+  switch (kind)
+  {
+    case ObjectKind:
+      result.l = env->CallStaticObjectMethodA(jClass, methodID, arguments);
+      break;
+    case BooleanKind:
+      result.z = env->CallStaticBooleanMethodA(jClass, methodID, arguments);
+      break;
+    case ByteKind:
+      result.b = env->CallStaticByteMethodA(jClass, methodID, arguments);
+      break;
+    case CharKind:
+      result.c = env->CallStaticCharMethodA(jClass, methodID, arguments);
+      break;
+    case ShortKind:
+      result.s = env->CallStaticShortMethodA(jClass, methodID, arguments);
+      break;
+    case IntKind:
+      result.i = env->CallStaticIntMethodA(jClass, methodID, arguments);
+      break;
+    case LongKind:
+      result.j = env->CallStaticLongMethodA(jClass, methodID, arguments);
+      break;
+    case FloatKind:
+      result.f = env->CallStaticFloatMethodA(jClass, methodID, arguments);
+      break;
+    case DoubleKind:
+      result.d = env->CallStaticDoubleMethodA(jClass, methodID, arguments);
+      break;
+    case VoidKind:
+      env->CallStaticVoidMethodA(jClass, methodID, arguments);
+      break;
+  }
+  return result;
+}
+
+
+/**
+ * Releases a result that is not needed, by deleting its local reference if it has one.
+ */
+void JMethodHelper::release(JNIEnv* env, JTypeKind kind, jvalue result)
+{
+  if (kind == ObjectKind && result.l)
+    env->DeleteLocalRef(result.l);
+}
+
+
+/**
+ * Invokes the method on the supplied object.
+ */
+jvalue JMethodHelper::invoke(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const JObject& object,
+  const JValue* const* values, jvalue* arguments, size_t count)
+{
+#ifdef JACE_CHECK_NULLS
+  if (object.isNull())
+    throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
+#endif
+
+  // Get the methodID for the method matching the given arguments.
+  jmethodID methodID = getMethodID(object.getJavaJniClass(), resultClass, values, count, false);
+
+  // Call the method.
+  jvalue result = call(env, kind, static_cast<jobject>(object), methodID, arguments);
+
+  // Catch any java exception that occured during the method call, and throw it as a C++ exception.
+  catchAndThrow(env);
+  return result;
+}
+
+
+/**
+ * Invokes the method statically, on the supplied class.
+ */
+jvalue JMethodHelper::invokeStatic(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const JClass& jClass,
+  const JValue* const* values, jvalue* arguments, size_t count)
+{
+  jmethodID methodID = getMethodID(jClass, resultClass, values, count, true);
+  jvalue result = callStatic(env, kind, jClass.getClass(), methodID, arguments);
+  catchAndThrow(env);
+  return result;
+}
+
+
+/**
+ * Invokes the method on the supplied object, storing any java exception it throws in error.
+ */
+jvalue JMethodHelper::tryInvoke(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const JObject& object,
+  const JValue* const* values, jvalue* arguments, size_t count, JavaThrowable& error)
+{
+#ifdef JACE_CHECK_NULLS
+  if (object.isNull())
+    throw JNIException("[JMethod.tryInvoke] Can not invoke an instance method on a null object.");
+#endif
+
+  jmethodID methodID = getMethodID(object.getJavaJniClass(), resultClass, values, count, false);
+  jvalue result = call(env, kind, static_cast<jobject>(object), methodID, arguments);
+
+  // A method that threw returns null (or zero), so there is no result to release.
+  error = JavaThrowable::takePending(env);
+  return result;
+}
+
+
+/**
+ * Invokes the method statically, storing any java exception it throws in error.
+ */
+jvalue JMethodHelper::tryInvokeStatic(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const JClass& jClass,
+  const JValue* const* values, jvalue* arguments, size_t count, JavaThrowable& error)
+{
+  jmethodID methodID = getMethodID(jClass, resultClass, values, count, true);
+  jvalue result = callStatic(env, kind, jClass.getClass(), methodID, arguments);
+  error = JavaThrowable::takePending(env);
+  return result;
+}
+
+
+/**
+ * Looks up the jmethodID, and caches it.
+ */
+jmethodID JMethodHelper::lookupMethodID(const JClass& jClass, ClassGetter resultClass,
+  const JValue* const* values, size_t count, bool isStatic)
+{
+  // Prefer the declaring class, if we were given one.
+  const JClass& parentClass = mClass ? *mClass : jClass;
+
+  // If we don't already have the jmethodID, we need to determine the signature of this method.
+  string methodSignature = mSignature;
+  if (methodSignature.empty())
+  {
+    JSignature signature(resultClass());
+    for (size_t i = 0; i < count; ++i)
+      signature << values[i]->getJavaJniClass();
+
+    methodSignature = signature.toString();
+  }
+
+  // Now that we have the signature for the method, look it up in the global cache, which shares
+  // the jmethodID between all JMethods referring to this method.
+  jmethodID methodID = JMemberRegistry::getMethodID(parentClass, mName, methodSignature, isStatic);
+
+  if (methodID == 0)
+  {
+    THROW_JNI_EXCEPTION(string("JMethod::getMethodID\n") +
+                        "Unable to find method <" + mName + "> with signature <" + methodSignature + ">");
+  }
+
+  // Concurrent lookups of the same method all yield the same jmethodID, so the last store wins harmlessly.
+  mMethodID.store(methodID, boost::memory_order_release);
+  return methodID;
+}
+
+END_NAMESPACE(jace)
@@ -0,0 +1,192 @@
+#include "jace/JResult.h"
+
+#include "jace/Jace.h"
+#include "jace/JNIException.h"
+
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+
+#include <string>
+using std::string;
+
+BEGIN_NAMESPACE(jace)
+
+const nothrow_t nothrow = nothrow_t();
+
+namespace
+{
+	/**
+	 * Clears the exception thrown while inspecting a throwable, and reports it as a JNIException.
+	 */
+	void checkInspection(JNIEnv* env, const string& what)
+	{
+		if (env->ExceptionCheck())
+		{
+			env->ExceptionClear();
+			THROW_JNI_EXCEPTION(string("JavaThrowable: An error occurred while trying to call ") + what);
+		}
+	}
+
+	/**
+	 * Throws a JNIException for a class or method that could not be looked up, clearing
+	 * the java exception left pending by the lookup, if any.
+	 */
+	void failInspection(JNIEnv* env, const string& what)
+	{
+		env->ExceptionClear();
+		THROW_JNI_EXCEPTION(string("JavaThrowable: Unable to find ") + what);
+	}
+
+	/**
+	 * Converts a java string to a std::string, and deletes the local reference.
+	 */
+	string toStdString(JNIEnv* env, jstring str)
+	{
+		if (!str)
+			return string();
+
+		const char* utfString = env->GetStringUTFChars(str, 0);
+		if (!utfString)
+		{
+			env->DeleteLocalRef(str);
+			THROW_JNI_EXCEPTION("JavaThrowable: Unable to retrieve the character string of a java string.");
+		}
+		string result = utfString;
+		env->ReleaseStringUTFChars(str, utfString);
+		env->DeleteLocalRef(str);
+		return result;
+	}
+} // namespace
+
+
+/**
+ * Creates a null JavaThrowable, representing the absence of an exception.
+ */
+JavaThrowable::JavaThrowable()
+{}
+
+
+/**
+ * Creates a JavaThrowable holding a new global reference to the given throwable.
+ */
+JavaThrowable::JavaThrowable(jthrowable throwable)
+{
+	if (throwable)
+		mThrowable = boost::shared_ptr<_jobject>(newGlobalRef(throwable), static_cast<void (*)(jobject)>(&deleteGlobalRef));
+}
+
+
+/**
+ * Clears the exception pending on the current thread, if any, and returns it.
+ */
+JavaThrowable JavaThrowable::takePending(JNIEnv* env)
+{
+	if (!env->ExceptionCheck())
+		return JavaThrowable();
+
+	jthrowable throwable = env->ExceptionOccurred();
+	env->ExceptionClear();
+
+	JavaThrowable result(throwable);
+	env->DeleteLocalRef(throwable);
+	return result;
+}
+
+
+/**
+ * Returns true if this JavaThrowable does not hold an exception.
+ */
+bool JavaThrowable::isNull() const
+{
+	return !mThrowable;
+}
+
+
+/**
+ * Returns the global reference to the throwable.
+ */
+jthrowable JavaThrowable::getThrowable() const
+{
+	return static_cast<jthrowable>(mThrowable.get());
+}
+
+
+/**
+ * Returns true if the throwable is an instance of the given class.
+ */
+bool JavaThrowable::isInstanceOf(const JClass& jClass) const
+{
+	if (isNull())
+		return false;
+
+	JNIEnv* env = attach();
+	return env->IsInstanceOf(getThrowable(), jClass.getClass()) == JNI_TRUE;
+}
+
+
+/**
+ * Returns the fully qualified name of the class of the throwable.
+ */
+string JavaThrowable::getClassName() const
+{
+	if (isNull())
+		return string();
+
+	JNIEnv* env = attach();
+	jclass throwableClass = env->GetObjectClass(getThrowable());
+	jclass classClass = env->GetObjectClass(throwableClass);
+	jmethodID getName = JMemberRegistry::getMethodID(classClass, "java/lang/Class", "getName", "()Ljava/lang/String;");
+	env->DeleteLocalRef(classClass);
+	if (!getName)
+	{
+		env->DeleteLocalRef(throwableClass);
+		failInspection(env, "the method, Class.getName().");
+	}
+
+	jstring name = static_cast<jstring>(env->CallObjectMethod(throwableClass, getName));
+	env->DeleteLocalRef(throwableClass);
+	checkInspection(env, "getName() on the class of the throwable.");
+	return toStdString(env, name);
+}
+
+
+/**
+ * Returns the result of Throwable.getMessage(), or an empty string if it is null.
+ */
+string JavaThrowable::getMessage() const
+{
+	if (isNull())
+		return string();
+
+	JNIEnv* env = attach();
+	jclass throwableClass = env->FindClass("java/lang/Throwable");
+	if (!throwableClass)
+		failInspection(env, "the class, java.lang.Throwable.");
+
+	jmethodID getMessage = JMemberRegistry::getMethodID(throwableClass, "java/lang/Throwable", "getMessage",
+		"()Ljava/lang/String;");
+	env->DeleteLocalRef(throwableClass);
+	if (!getMessage)
+		failInspection(env, "the method, Throwable.getMessage().");
+
+	jstring message = static_cast<jstring>(env->CallObjectMethod(getThrowable(), getMessage));
+	checkInspection(env, "getMessage() on the throwable.");
+	return toStdString(env, message);
+}
+
+
+/**
+ * Throws the matching C++ proxy exception, as catchAndThrow() would have.
+ */
+void JavaThrowable::rethrow() const
+{
+	if (isNull())
+		THROW_JNI_EXCEPTION("JavaThrowable::rethrow(): There is no exception to rethrow.");
+
+	JNIEnv* env = attach();
+	if (env->Throw(getThrowable()) != 0)
+		THROW_JNI_EXCEPTION("JavaThrowable::rethrow(): Unable to throw the exception.");
+	catchAndThrow(env);
+}
+
+END_NAMESPACE(jace)
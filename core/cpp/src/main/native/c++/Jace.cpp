@@ -1,5 +1,10 @@
 #include "jace/Jace.h"
 using jace::JFactory;
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+#include "jace/LocalFrame.h"
+#include "jace/RefTracker.h"
+using jace::RefTracker;
 using jace::VmLoader;
 using jace::VirtualMachineShutdownError;
 using jace::VirtualMachineRunningError;
@@ -30,9 +35,25 @@ using std::string;
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/tss.hpp>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/config.hpp>
+
+/**
+ * Declares a variable with thread storage duration, for the JNIEnv cache of attach().
+ */
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+#  define JACE_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#  define JACE_THREAD_LOCAL __declspec(thread)
+#else
+#  define JACE_THREAD_LOCAL __thread
+#endif
 
 BEGIN_NAMESPACE(jace)
 
+const with_env_t with_env = with_env_t();
+
 // A reference to the java virtual machine.
 // We're under the assumption that there will always only be one of these.
 JavaVM* jvm = 0;
@@ -48,6 +69,28 @@ typedef boost::unique_lock<boost::shared_mutex>             auto_write_lock;
 typedef boost::upgrade_lock<boost::shared_mutex>            auto_upgrade_lock;
 typedef boost::upgrade_to_unique_lock<boost::shared_mutex>  auto_upgrade_unique_lock;
 
+/**
+ * Incremented, under the write lock of jvmMtx, whenever "jvm" changes.
+ *
+ * Each thread caches its JNIEnv along with the generation it was obtained in.
+ * The cache is only used while the generation is unchanged, so attach() can skip
+ * jvmMtx and GetEnv() in the common case.
+ */
+boost::atomic<unsigned long> vmGeneration(0);
+JACE_THREAD_LOCAL JNIEnv* cachedEnv = 0;
+JACE_THREAD_LOCAL unsigned long cachedGeneration = 0;
+
+/**
+ * The global references queued by releaseGlobalRef() in deferred reclamation mode.
+ *
+ * attach() deletes them once there are at least reclaimBatchSize, so that they are
+ * deleted in batches, without making every call pay for it.
+ */
+boost::atomic<bool> deferredReclamation(false);
+boost::lockfree::queue<jobject> pendingReclaims(128);
+boost::atomic<size_t> pendingReclaimCount(0);
+const size_t reclaimBatchSize = 64;
+
 /* The map of all of the java class factories. */
 typedef map<string,JFactory*> FactoryMap;
 FactoryMap* getFactoryMap() {
@@ -67,24 +110,220 @@ std::string asString(JNIEnv* env, jstring str) {
 	return stdString;
 }
 
+/**
+ * The nearest enlisted factory of each exception class catchAndThrow() has translated, and the
+ * name of the class, so that an exception of a class seen before is translated without walking
+ * its superclasses. Classes without any enlisted factory are cached too, with a null factory.
+ *
+ * The first classes translated are kept in a small table, and told apart with IsSameObject()
+ * alone, so that the handful of exception classes a program typically throws are found without
+ * any call into the virtual machine. The classes past those are keyed by their identity hash code.
+ */
+struct ExceptionFactoryEntry {
+    ExceptionFactoryEntry(): exceptionClass(0), factory(0) {}
+
+    jclass exceptionClass;
+    JFactory* factory;
+    string className;
+};
+typedef std::multimap<jint, ExceptionFactoryEntry> ExceptionFactoryMap;
+
+const size_t directExceptionClasses = 16;
+
+struct ExceptionCache {
+    ExceptionCache(): directCount(0), generation(0) {}
+
+    boost::shared_mutex mutex;
+    ExceptionFactoryEntry direct[directExceptionClasses];
+    size_t directCount;
+    ExceptionFactoryMap factories;
+    /* Incremented whenever the cache is cleared, so that a stale lookup is not cached */
+    unsigned long generation;
+};
+
+/* Constructed on first use, as enlist() runs during static initialization */
+ExceptionCache& getExceptionCache() {
+	static ExceptionCache cache;
+	return cache;
+}
+
+/**
+ * Looks up a class in the table of the exception cache, without calling into the virtual machine.
+ * Must be called with its mutex held.
+ *
+ * @return false if the class is not in the table
+ */
+bool findDirectExceptionFactory(JNIEnv* env, const ExceptionCache& cache, jclass exceptionClass,
+                                ExceptionFactoryEntry& entry) {
+	for (size_t i = 0; i < cache.directCount; ++i) {
+		if (env->IsSameObject(cache.direct[i].exceptionClass, exceptionClass) == JNI_TRUE) {
+			entry = cache.direct[i];
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Looks up a class, by its identity hash code, among the classes past the table of the exception cache.
+ * Must be called with its mutex held.
+ *
+ * @return false if the class is not found
+ */
+bool findHashedExceptionFactory(JNIEnv* env, const ExceptionCache& cache, jint key, jclass exceptionClass,
+                                ExceptionFactoryEntry& entry) {
+	std::pair<ExceptionFactoryMap::const_iterator, ExceptionFactoryMap::const_iterator> range =
+		cache.factories.equal_range(key);
+	for (ExceptionFactoryMap::const_iterator it = range.first; it != range.second; ++it) {
+		if (env->IsSameObject(it->second.exceptionClass, exceptionClass) == JNI_TRUE) {
+			entry = it->second;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Returns Class.getName() */
+jmethodID getClassGetName(JNIEnv* env) {
+	jclass classClass = env->FindClass("java/lang/Class");
+	if (!classClass) {
+		env->ExceptionClear();
+		throw JNIException("Assert failed: Unable to find the class, java.lang.Class.");
+	}
+	jmethodID classGetName = env->GetMethodID(classClass, "getName", "()Ljava/lang/String;");
+	env->DeleteLocalRef(classClass);
+	if (!classGetName) {
+		env->ExceptionClear();
+		throw JNIException("Assert failed: Unable to find the method, Class.getName().");
+	}
+	return classGetName;
+}
+
+/* Returns the name of a class, such as "java.lang.String" */
+string getClassName(JNIEnv* env, jmethodID classGetName, jclass cls) {
+	jstring name = static_cast<jstring>(env->CallObjectMethod(cls, classGetName));
+	if (env->ExceptionOccurred()) {
+		env->ExceptionDescribe();
+		throw JNIException("jace::catchAndThrow()\nAn error occurred while trying to call "
+			               "getName() on the class of the thrown exception.");
+	}
+	string result = asString(env, name);
+	env->DeleteLocalRef(name);
+	return result;
+}
+
+/**
+ * Returns the factory enlisted for the nearest class of exceptionClass, or null if there is none,
+ * along with the name of exceptionClass.
+ */
+JFactory* getExceptionFactory(JNIEnv* env, jclass exceptionClass, string& className) {
+	ExceptionCache& cache = getExceptionCache();
+	ExceptionFactoryEntry entry;
+	{
+		auto_read_lock readLock(cache.mutex);
+		if (findDirectExceptionFactory(env, cache, exceptionClass, entry)) {
+			className = entry.className;
+			return entry.factory;
+		}
+	}
+
+	// The hash code costs a call into the virtual machine, so it is computed outside of the lock
+	jint key = identityHashCode(env, exceptionClass);
+	unsigned long generation;
+	{
+		auto_read_lock readLock(cache.mutex);
+		if (findHashedExceptionFactory(env, cache, key, exceptionClass, entry)) {
+			className = entry.className;
+			return entry.factory;
+		}
+		generation = cache.generation;
+	}
+
+	// Walk up the superclasses of the exception, until one has an enlisted factory. This is done
+	// outside of the lock too, as naming each class calls into the virtual machine.
+	jmethodID classGetName = getClassGetName(env);
+	entry.className = getClassName(env, classGetName, exceptionClass);
+	string name = entry.className;
+	jclass cls = static_cast<jclass>(env->NewLocalRef(exceptionClass));
+	while (cls) {
+		if (name == "java.lang.Object") {
+			break;
+		}
+		FactoryMap::iterator match = getFactoryMap()->find(name);
+		if (match != getFactoryMap()->end()) {
+			entry.factory = match->second;
+			break;
+		}
+		jclass superClass = env->GetSuperclass(cls);
+		env->DeleteLocalRef(cls);
+		cls = superClass;
+		if (cls) {
+			name = getClassName(env, classGetName, cls);
+		}
+	}
+	env->DeleteLocalRef(cls);
+	className = entry.className;
+
+	auto_write_lock writeLock(cache.mutex);
+	// Another thread may have cached the class meanwhile, or enlist() may have cleared the cache
+	ExceptionFactoryEntry cached;
+	if (cache.generation != generation || findDirectExceptionFactory(env, cache, exceptionClass, cached) ||
+	    findHashedExceptionFactory(env, cache, key, exceptionClass, cached)) {
+		return entry.factory;
+	}
+
+	entry.exceptionClass = static_cast<jclass>(newGlobalRef(env, exceptionClass));
+	if (cache.directCount < directExceptionClasses) {
+		cache.direct[cache.directCount++] = entry;
+	} else {
+		cache.factories.insert(ExceptionFactoryMap::value_type(key, entry));
+	}
+	return entry.factory;
+}
+
+/**
+ * Empties the exception cache, deleting its references through env, or forgetting them if env is null.
+ */
+void clearExceptionCache(JNIEnv* env) {
+	ExceptionCache& cache = getExceptionCache();
+	auto_write_lock writeLock(cache.mutex);
+	if (env) {
+		for (size_t i = 0; i < cache.directCount; ++i) {
+			deleteGlobalRef(env, cache.direct[i].exceptionClass);
+		}
+		for (ExceptionFactoryMap::iterator it = cache.factories.begin(); it != cache.factories.end(); ++it) {
+			deleteGlobalRef(env, it->second.exceptionClass);
+		}
+	}
+	for (size_t i = 0; i < cache.directCount; ++i) {
+		cache.direct[i] = ExceptionFactoryEntry();
+	}
+	cache.directCount = 0;
+	cache.factories.clear();
+	++cache.generation;
+}
+
 /* Automatically-detaching pointer */
 void threadDetacher(JNIEnv**) { detach(); }
 boost::thread_specific_ptr<JNIEnv*> attachedJni(threadDetacher);
 /**
- * Attaches the current thread to the virtual machine and returns the appropriate
- * JNIEnv for the thread. If the thread is already attached, this method method
- * does nothing.
+ * Attaches the current thread to the virtual machine under the given name and thread group,
+ * and returns the appropriate JNIEnv for the thread. If the thread is already attached,
+ * this method does nothing.
  *
  * PRECONDITION: jvm is not null, jniVersion is not 0, and jvmMtx is read-locked
  *
  * @param jvm the java virtual machine to attach the thread to
  * @param jniVersion the version of the vm that we want to attach
+ * @param threadGroup the java thread group of the thread, or null for the main thread group
+ * @param name the name of the java thread, or null for a default name
  * @param daemon true if the thread should be attached as a daemon thread
  * @throws JNIException if an error occurs while trying to attach the current thread.
  * @see AttachCurrentThread
  * @see AttachCurrentThreadAsDaemon
  */
-JNIEnv* attachImpl(JavaVM* jvm, jint jniVersion, const bool mainThread) /* throw (JNIException) */ {
+JNIEnv* attachImpl(JavaVM* jvm, jint jniVersion, const jobject threadGroup, const char* name,
+                   const bool daemon) /* throw (JNIException) */ {
 	JNIEnv* env;
 	if (jvm->GetEnv((void**) &env, jniVersion) == JNI_OK)
 	{
@@ -94,20 +333,21 @@ JNIEnv* attachImpl(JavaVM* jvm, jint jniVersion, const bool mainThread) /* throw
 
 	JavaVMAttachArgs args;
 	args.version = jniVersion;
-	string temp("NativeThread-");
-	temp += toString(boost::this_thread::get_id());
 #ifdef __ANDROID__
 #define _JACE_ENV_CAST
-    args.name = temp.c_str();
+    args.name = name;
 #else
 #define _JACE_ENV_CAST (void**)
-    args.name = new char[temp.length() + 1];
-    strcpy(args.name, temp.c_str());
+    args.name = 0;
+    if (name) {
+        args.name = new char[strlen(name) + 1];
+        strcpy(args.name, name);
+    }
 #endif
 
-	args.group = 0;
+	args.group = threadGroup;
 	jint result;
-	if (mainThread || mainThreadId == boost::thread::id() || mainThreadId == boost::this_thread::get_id()) {
+	if (!daemon) {
 		result = jvm->AttachCurrentThread(_JACE_ENV_CAST &env, &args);
 	} else {
 		result = jvm->AttachCurrentThreadAsDaemon(_JACE_ENV_CAST &env, &args);
@@ -132,6 +372,36 @@ JNIEnv* attachImpl(JavaVM* jvm, jint jniVersion, const bool mainThread) /* throw
 	return env;
 }
 
+/**
+ * Attaches the current thread to the virtual machine and returns the appropriate
+ * JNIEnv for the thread. If the thread is already attached, this method method
+ * does nothing.
+ *
+ * Threads other than the main thread are attached as daemon threads, and named
+ * after their boost::thread id.
+ *
+ * PRECONDITION: jvm is not null, jniVersion is not 0, and jvmMtx is read-locked
+ *
+ * @param jvm the java virtual machine to attach the thread to
+ * @param jniVersion the version of the vm that we want to attach
+ * @param mainThread true if the thread is the main thread
+ * @throws JNIException if an error occurs while trying to attach the current thread.
+ */
+JNIEnv* attachImpl(JavaVM* jvm, jint jniVersion, const bool mainThread) /* throw (JNIException) */ {
+	JNIEnv* env;
+	if (jvm->GetEnv((void**) &env, jniVersion) == JNI_OK)
+	{
+		// Already attached
+		return env;
+	}
+
+	string name("NativeThread-");
+	name += toString(boost::this_thread::get_id());
+	bool daemon = !(mainThread || mainThreadId == boost::thread::id() ||
+	                mainThreadId == boost::this_thread::get_id());
+	return attachImpl(jvm, jniVersion, 0, name.c_str(), daemon);
+}
+
 /**
  * Allows createVm() and setJavaVm() to share code without recursive mutexes.
  *
@@ -146,6 +416,7 @@ void setJavaVmImpl(JavaVM* _jvm, jint _jniVersion, auto_upgrade_lock& upgradeLoc
 	    jvm = _jvm;
 	    jniVersion = env->GetVersion();
         mainThreadId = boost::this_thread::get_id();
+        vmGeneration.fetch_add(1, boost::memory_order_release);
     }
 }
 
@@ -200,6 +471,19 @@ void setJavaVm(JavaVM* _jvm, jint _jniVersion) {
 
 /** Implementation of resetJavaVm() */
 void resetJavaVm() {
+    /* Delete the references queued for reclamation, and those of the exception cache, while they are still valid */
+    try {
+        JNIEnv* env = attach();
+        reclaimGlobalRefs(env);
+        clearExceptionCache(env);
+    } catch (VirtualMachineShutdownError&) {
+        clearExceptionCache(0);
+    }
+#ifdef JACE_TRACK_REFS
+    /* Whatever is still live now was leaked, or belongs to proxies that outlive the virtual machine */
+    RefTracker::check(cerr);
+#endif
+
 	auto_upgrade_lock upgradeLock(jvmMtx);
     if (jvm == 0) {
         // JVM already shut down
@@ -213,6 +497,7 @@ void resetJavaVm() {
             jvm = 0;
             jniVersion = 0;
             mainThreadId = boost::thread::id();
+            vmGeneration.fetch_add(1, boost::memory_order_release);
         }
 
     	// DestroyJavaVM()'s return value is only reliable under JDK 1.6 or newer; older versions always
@@ -226,20 +511,58 @@ void resetJavaVm() {
         jvm = 0;
         jniVersion = 0;
         mainThreadId = boost::thread::id();
+        vmGeneration.fetch_add(1, boost::memory_order_release);
     }
     /* And reset the loader so things get cleaned up */
     g_loader.reset();
+
+    /* Member ids are only valid for the virtual machine that returned them */
+    JMemberRegistry::reset();
+
+    /* So are global references, which went away with it */
+    jobject ref;
+    while (pendingReclaims.pop(ref)) {
+        pendingReclaimCount.fetch_sub(1, boost::memory_order_relaxed);
+    }
+    RefTracker::reset();
 }
 
 JavaVM* getJavaVm() { return jvm; }
 
 /** Implementation of attach() */
 JNIEnv* attach() {
+    /* Fast path: this thread already attached to the current virtual machine */
+    JNIEnv* env = cachedEnv;
+    if (env && cachedGeneration == vmGeneration.load(boost::memory_order_acquire)) {
+        if (pendingReclaimCount.load(boost::memory_order_relaxed) >= reclaimBatchSize) {
+            reclaimGlobalRefs(env);
+        }
+        return env;
+    }
+
+    auto_read_lock readLock(jvmMtx);
+	if (jvm == 0 || jniVersion == 0 || mainThreadId == boost::thread::id()) {
+		throw VirtualMachineShutdownError("The virtual machine is shut down");
+    }
+	env = attachImpl(jvm, jniVersion, false);
+
+    /* The generation only changes under the write lock, so it matches the jvm we attached to */
+    cachedEnv = env;
+    cachedGeneration = vmGeneration.load(boost::memory_order_relaxed);
+    return env;
+}
+
+/** Implementation of attach(const jobject, const char*, const bool) */
+JNIEnv* attach(const jobject threadGroup, const char* name, const bool daemon) {
     auto_read_lock readLock(jvmMtx);
 	if (jvm == 0 || jniVersion == 0 || mainThreadId == boost::thread::id()) {
 		throw VirtualMachineShutdownError("The virtual machine is shut down");
     }
-	return attachImpl(jvm, jniVersion, false);
+	JNIEnv* env = attachImpl(jvm, jniVersion, threadGroup, name, daemon);
+
+    cachedEnv = env;
+    cachedGeneration = vmGeneration.load(boost::memory_order_relaxed);
+    return env;
 }
 
 /** Implementation of detach() */
@@ -250,13 +573,18 @@ void detach() {
 		return;
 	}
 	jvm->DetachCurrentThread();
+    cachedEnv = 0;
     /* Release instead of reset so we don't keep getting called */
     attachedJni.release();
 }
 
 /** Implementation of newLocalRef() */
 jobject newLocalRef(jobject ref) {
-    JNIEnv* env = attach();
+	return newLocalRef(attach(), ref);
+}
+
+/** Implementation of newLocalRef(JNIEnv*, jobject) */
+jobject newLocalRef(JNIEnv* env, jobject ref) {
 	jobject localRef = env->NewLocalRef(ref);
 	if (!localRef) {
 		throw JNIException(string("Jace::newLocalRef\n") +
@@ -264,6 +592,7 @@ jobject newLocalRef(jobject ref) {
 			                      "It is likely that you have exceeded the maximum local reference count.\n" +
 			                      "You can increase the maximum count with a call to EnsureLocalCapacity().");
 	}
+	JACE_REF_CREATED(Local, localRef, "newLocalRef");
 	return localRef;
 }
 
@@ -271,19 +600,31 @@ jobject newLocalRef(jobject ref) {
 void deleteLocalRef(jobject localRef) {
     try {
         JNIEnv* env = attach();
+        JACE_REF_DELETED(Local, localRef);
     	env->DeleteLocalRef(localRef), localRef = 0;
     } catch (...) {}
 }
 
+/** Implementation of deleteLocalRef(JNIEnv*, jobject) */
+void deleteLocalRef(JNIEnv* env, jobject localRef) {
+	JACE_REF_DELETED(Local, localRef);
+	env->DeleteLocalRef(localRef), localRef = 0;
+}
+
 /** Implementation of newGlobalRef() */
 jobject newGlobalRef(jobject ref) {
-    JNIEnv* env = attach();
+	return newGlobalRef(attach(), ref);
+}
+
+/** Implementation of newGlobalRef(JNIEnv*, jobject) */
+jobject newGlobalRef(JNIEnv* env, jobject ref) {
 	jobject globalRef = env->NewGlobalRef(ref);
 	if (!globalRef) {
 		throw JNIException(string("Jace::newGlobalRef\n") +
 			                      "Unable to create a new global reference.\n" +
 			                      "It is likely that you have exceeded the max heap size of your virtual machine.");
 	}
+	JACE_REF_CREATED(Global, globalRef, "newGlobalRef");
 	return globalRef;
 }
 
@@ -291,151 +632,200 @@ jobject newGlobalRef(jobject ref) {
 void deleteGlobalRef(jobject globalRef) {
     try {
         JNIEnv* env = attach();
+        JACE_REF_DELETED(Global, globalRef);
 	    env->DeleteGlobalRef(globalRef), globalRef = 0;
     } catch (...) {}
 }
 
-/** Implementation of enlist() */
-void enlist(JFactory* factory) {
-	string name = factory->getClass().getInternalName();
-	replace(name.begin(), name.end(), '/', '.');
-	getFactoryMap()->insert(FactoryMap::value_type(name, factory));
+/** Implementation of deleteGlobalRef(JNIEnv*, jobject) */
+void deleteGlobalRef(JNIEnv* env, jobject globalRef) {
+	JACE_REF_DELETED(Global, globalRef);
+	env->DeleteGlobalRef(globalRef), globalRef = 0;
 }
 
-/** Implementation of catchAndThrow() */
-void catchAndThrow() {
-    JNIEnv* env = attach();
-	if (!env->ExceptionCheck()) {
-        /* No exception */
-		return;
-    }
+/** Implementation of newWeakGlobalRef(JNIEnv*, jobject) */
+jobject newWeakGlobalRef(JNIEnv* env, jobject ref) {
+	jobject weakRef = env->NewWeakGlobalRef(ref);
+	if (!weakRef && ref) {
+		if (env->ExceptionCheck()) {
+			env->ExceptionClear();
+		} else if (env->IsSameObject(ref, 0) == JNI_TRUE) {
+			/* ref is a weak reference whose object was collected */
+			return 0;
+		}
+		throw JNIException(string("Jace::newWeakGlobalRef\n") +
+			                      "Unable to create a new weak global reference.");
+	}
+	return weakRef;
+}
 
-	jthrowable jexception = env->ExceptionOccurred();
-	env->ExceptionClear();
+/** Implementation of deleteWeakGlobalRef() */
+void deleteWeakGlobalRef(jobject weakRef) {
+    try {
+        JNIEnv* env = attach();
+	    env->DeleteWeakGlobalRef(weakRef), weakRef = 0;
+    } catch (...) {}
+}
 
-	// Find the fully qualified name for the exception type, so
-	// we can find a matching C++ proxy exception.
-	//
-	// In java, this looks like:
-	//   String typeName = exception.getClass().getName();
-	jclass throwableClass = env->FindClass("java/lang/Throwable");
-	if (!throwableClass) {
-		string msg = "Assert failed: Unable to find the class, java.lang.Throwable.";
-		throw JNIException(msg);
-	}
+/**
+ * The handles identityHashCode() calls through, resolved once per virtual machine.
+ */
+struct SystemHandles {
+	unsigned long generation;
+	jclass systemClass;
+	jmethodID identityHashCode;
+};
+boost::atomic<SystemHandles*> systemHandles(0);
+boost::mutex systemHandlesMutex;
 
-	jclass classClass = env->FindClass("java/lang/Class");
-	if (!classClass) {
-		string msg = "Assert failed: Unable to find the class, java.lang.Class.";
-		throw JNIException(msg);
+/**
+ * Returns the handles of the current virtual machine, resolving them on first use.
+ * Only the first call after the virtual machine changes takes a lock.
+ */
+const SystemHandles& getSystemHandles(JNIEnv* env) {
+	unsigned long generation = vmGeneration.load(boost::memory_order_acquire);
+	SystemHandles* handles = systemHandles.load(boost::memory_order_acquire);
+	if (handles && handles->generation == generation) {
+		return *handles;
 	}
 
-	jmethodID throwableGetClass = env->GetMethodID(throwableClass, "getClass", "()Ljava/lang/Class;");
-	if (!throwableGetClass) {
-		string msg = "Assert failed: Unable to find the method, Throwable.getClass().";
-		throw JNIException(msg);
+	boost::mutex::scoped_lock lock(systemHandlesMutex);
+	handles = systemHandles.load(boost::memory_order_acquire);
+	if (handles && handles->generation == generation) {
+		return *handles;
 	}
 
-	env->DeleteLocalRef(throwableClass), throwableClass = 0;
-	jmethodID classGetName = env->GetMethodID(classClass, "getName", "()Ljava/lang/String;");
-	if (!classGetName) {
-		string msg = "Assert failed: Unable to find the method, Class.getName().";
-		throw JNIException(msg);
+	jclass systemClass = env->FindClass("java/lang/System");
+	if (!systemClass) {
+		env->ExceptionClear();
+		throw JNIException("Assert failed: Unable to find the class, java.lang.System.");
 	}
-
-	jmethodID classGetSuperclass = env->GetMethodID(classClass, "getSuperclass", "()Ljava/lang/Class;");
-	if (!classGetSuperclass) {
-		string msg = "Assert failed: Unable to find the method, Class.getSuperclass().";
-		throw JNIException(msg);
+	jmethodID identityHashCode = env->GetStaticMethodID(systemClass, "identityHashCode", "(Ljava/lang/Object;)I");
+	if (!identityHashCode) {
+		env->ExceptionClear();
+		env->DeleteLocalRef(systemClass);
+		throw JNIException("Assert failed: Unable to find the method, System.identityHashCode().");
 	}
 
-	env->DeleteLocalRef(classClass), classClass = 0;
-	jobject exceptionClass = env->CallObjectMethod(jexception, throwableGetClass);
-	if (env->ExceptionOccurred()) {
-		env->ExceptionDescribe();
-		string msg = string("jace::catchAndThrow()\n") +
-			                "An error occurred while trying to call getClass() on the thrown exception.";
-		throw JNIException(msg);
+	// Kept for the life of the virtual machine, as JClassImpl keeps its class
+	SystemHandles* newHandles = new SystemHandles;
+	newHandles->generation = generation;
+	newHandles->systemClass = static_cast<jclass>(env->NewGlobalRef(systemClass));
+	newHandles->identityHashCode = identityHashCode;
+	env->DeleteLocalRef(systemClass);
+
+	// The handles of a previous virtual machine are never deleted, as other threads may still be reading them
+	systemHandles.store(newHandles, boost::memory_order_release);
+	return *newHandles;
+}
+
+/** Implementation of identityHashCode() */
+jint identityHashCode(JNIEnv* env, jobject object) {
+	if (!object) {
+		return 0;
 	}
 
-	jstring exceptionType = static_cast<jstring>(env->CallObjectMethod(exceptionClass, classGetName));
-	if (env->ExceptionOccurred()) {
-		env->ExceptionDescribe();
-		string msg = string("jace::catchAndThrow()\n") +
-			                "An error occurred while trying to call getName() on the class of the thrown exception.";
-		throw JNIException(msg);
+	// catchAndThrow() hashes exception classes with this, so it must not translate failures itself
+	const SystemHandles& handles = getSystemHandles(env);
+	jint result = env->CallStaticIntMethod(handles.systemClass, handles.identityHashCode, object);
+	if (env->ExceptionCheck()) {
+		env->ExceptionClear();
+		throw JNIException("Jace::identityHashCode\nUnable to call System.identityHashCode().");
 	}
+	return result;
+}
 
-	string exceptionTypeString = asString(env, exceptionType);
-
-	// Now, find the matching factory for this exception type.
-	while (true) {
-		FactoryMap::iterator it = getFactoryMap()->find(exceptionTypeString);
-
-		// If we couldn't find a match, try to find the parent exception type.
-		if (it == getFactoryMap()->end())
-		{
-			jobject superClass = env->CallObjectMethod(exceptionClass, classGetSuperclass);
-
-			if (env->ExceptionOccurred()) {
-				env->ExceptionDescribe();
-				string msg = string("jace::catchAndThrow()\n") +
-					                "An error occurred while trying to call getSuperclass() on the thrown exception.";
-				throw JNIException(msg);
-			}
-
-			// We get NULL if we've already reached java.lang.Object, in which case,
-			// we couldn't find any match at all.
-			if (!superClass) {
-				break;
-            }
-
-			env->DeleteLocalRef(exceptionClass), exceptionClass = 0;
-			env->DeleteLocalRef(exceptionType), exceptionType = 0;
-			exceptionClass = superClass;
-
-			exceptionType = static_cast<jstring>(env->CallObjectMethod(exceptionClass, classGetName));
-
-			if (env->ExceptionOccurred()) {
-				env->ExceptionDescribe();
-				throw JNIException("jace::catchAndThrow()\nAn error occurred while trying to call "
-					               "getName() on the superclass of the thrown exception.");
-			}
-
-			exceptionTypeString = asString(env, exceptionType);
-			if (exceptionTypeString == "java.lang.Object") {
-				// Couldn't find a matching exception. Abort!
-				break;
-			}
-			continue;
-		}
+/** Implementation of releaseGlobalRef() */
+void releaseGlobalRef(jobject globalRef) {
+    if (!deferredReclamation.load(boost::memory_order_relaxed)) {
+        deleteGlobalRef(globalRef);
+        return;
+    }
+    /* Counted first, so that the count never falls below the number of queued references */
+    pendingReclaimCount.fetch_add(1, boost::memory_order_relaxed);
+    if (!pendingReclaims.push(globalRef)) {
+        /* The queue could not allocate a node, so there is nothing left but to delete it now */
+        pendingReclaimCount.fetch_sub(1, boost::memory_order_relaxed);
+        deleteGlobalRef(globalRef);
+    }
+}
 
-		// Ask the factory to throw the exception.
-		jvalue value;
-		value.l = jexception;
-		it->second->throwInstance(value);
-	}
+/** Implementation of setDeferredReclamation() */
+void setDeferredReclamation(bool enabled) {
+    deferredReclamation.store(enabled, boost::memory_order_relaxed);
+}
 
-	exceptionClass = env->CallObjectMethod(jexception, throwableGetClass);
+/** Implementation of isDeferredReclamation() */
+bool isDeferredReclamation() {
+    return deferredReclamation.load(boost::memory_order_relaxed);
+}
 
-	if (env->ExceptionOccurred()) {
-		env->ExceptionDescribe();
-		string msg = string("jace::catchAndThrow()\n") +
-			                "An error occurred while trying to call getClass() on the thrown exception.";
-		throw JNIException(msg);
+/** Implementation of reclaimGlobalRefs() */
+size_t reclaimGlobalRefs() {
+    return reclaimGlobalRefs(attach());
+}
+
+/** Implementation of reclaimGlobalRefs(JNIEnv*) */
+size_t reclaimGlobalRefs(JNIEnv* env) {
+    size_t count = 0;
+    jobject ref;
+    while (pendingReclaims.pop(ref)) {
+        JACE_REF_DELETED(Global, ref);
+        env->DeleteGlobalRef(ref);
+        ++count;
+    }
+    pendingReclaimCount.fetch_sub(count, boost::memory_order_relaxed);
+    return count;
+}
+
+/** Implementation of enlist() */
+void enlist(JFactory* factory) {
+	string name = factory->getClass().getInternalName();
+	replace(name.begin(), name.end(), '/', '.');
+	getFactoryMap()->insert(FactoryMap::value_type(name, factory));
+
+	/* The new factory may be nearer to the exception classes already translated */
+	if (getJavaVm()) {
+		JNIEnv* env = 0;
+		try {
+			env = attach();
+		} catch (VirtualMachineShutdownError&) {
+		}
+		clearExceptionCache(env);
 	}
+}
 
-	exceptionType = static_cast<jstring>(env->CallObjectMethod(exceptionClass, classGetName));
+/** Implementation of catchAndThrow() */
+void catchAndThrow() {
+	catchAndThrow(attach());
+}
 
-	if (env->ExceptionOccurred()) {
-		env->ExceptionDescribe();
-		string msg = string("jace::catchAndThrow()\n") +
-			                "An error occurred while trying to call getName() on the class of the thrown exception.";
-		throw JNIException(msg);
+/** Implementation of catchAndThrow(JNIEnv*) */
+void catchAndThrow(JNIEnv* env) {
+	if (!env->ExceptionCheck()) {
+        /* No exception */
+		return;
+    }
+
+	jthrowable jexception = env->ExceptionOccurred();
+	env->ExceptionClear();
+
+	// The class and name looked up below are released together, whichever way this returns.
+	// The proxy exception thrown holds its own global reference to the java exception.
+	LocalFrame frame(env);
+
+	// Find the factory enlisted for the exception type, or its nearest superclass, so
+	// we can throw a matching C++ proxy exception.
+	jclass exceptionClass = env->GetObjectClass(jexception);
+	string className;
+	JFactory* factory = getExceptionFactory(env, exceptionClass, className);
+	if (factory) {
+		jvalue value;
+		value.l = jexception;
+		factory->throwInstance(value);
 	}
 
-	exceptionTypeString = asString(env, exceptionType);
-	string msg = string("Can't find any linked in parent exception for ") + exceptionTypeString + "\n";
+	string msg = string("Can't find any linked in parent exception for ") + className + "\n";
 	throw JNIException(msg);
 }
 
@@ -0,0 +1,345 @@
+#include "jace/JvmExecutor.h"
+
+#include "jace/Jace.h"
+#include "jace/JNIException.h"
+#include "jace/LocalFrame.h"
+
+#include <boost/bind.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <cassert>
+
+#include <string>
+using std::string;
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	void noCleanup(void*)
+	{}
+
+	/**
+	 * The JvmExecutor worker running on the current thread, if any. Not owned.
+	 */
+	boost::thread_specific_ptr<void> currentWorker(noCleanup);
+} // namespace
+
+
+/**
+ * Starts the workers, and attaches them to the virtual machine.
+ */
+JvmExecutor::JvmExecutor(size_t threads, bool daemon, const string& namePrefix, size_t capacity):
+	mPending(0), mCapacity(capacity), mStopping(false), mStartedCount(0), mNextWorker(0)
+{
+	if (threads == 0)
+		threads = boost::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	mWorkers.reserve(threads);
+	for (size_t i = 0; i < threads; ++i)
+	{
+		boost::shared_ptr<Worker> worker(new Worker);
+		worker->executor = this;
+		worker->index = i;
+		mWorkers.push_back(worker);
+	}
+
+	for (size_t i = 0; i < threads; ++i)
+	{
+		Worker* worker = mWorkers[i].get();
+		worker->thread = boost::thread(boost::bind(&JvmExecutor::run, this, worker, daemon,
+			namePrefix + toString(i)));
+	}
+
+	// Wait until every worker is attached, so that a failure is reported to the caller
+	string error;
+	{
+		boost::unique_lock<boost::mutex> lock(mIdleMutex);
+		while (mStartedCount < threads)
+			mStarted.wait(lock);
+		error = mStartError;
+	}
+
+	if (!error.empty())
+	{
+		shutdown();
+		throw JNIException("JvmExecutor: Unable to attach a worker to the virtual machine.\n" + error);
+	}
+}
+
+
+/**
+ * Runs the remaining tasks, and stops the workers.
+ */
+JvmExecutor::~JvmExecutor()
+{
+	// A worker can not join itself, so destroying an executor from one of its tasks is a usage error
+	assert(!isWorkerThread());
+	try
+	{
+		shutdown();
+	}
+	catch (JNIException&)
+	{
+		// The workers can not be stopped, so they are detached instead of being joined
+		for (size_t i = 0; i < mWorkers.size(); ++i)
+			mWorkers[i]->thread.detach();
+	}
+}
+
+
+/**
+ * Queues a task.
+ */
+void JvmExecutor::submit(const Task& task)
+{
+	enqueue(task, true);
+}
+
+
+/**
+ * Queues a task, unless the executor is at capacity.
+ */
+bool JvmExecutor::trySubmit(const Task& task)
+{
+	return enqueue(task, false);
+}
+
+
+/**
+ * Queues a task, waiting for room if block is true.
+ */
+bool JvmExecutor::enqueue(const Task& task, bool block)
+{
+	Worker* worker = static_cast<Worker*>(currentWorker.get());
+	if (!worker || worker->executor != this)
+		worker = 0;
+
+	// Idle workers check mPending under mIdleMutex, so neither the task nor the wakeup can be lost
+	boost::unique_lock<boost::mutex> lock(mIdleMutex);
+	while (true)
+	{
+		if (mStopping)
+			throw JNIException("JvmExecutor::submit: The executor has been shut down.");
+		if (mCapacity == 0 || worker || mPending.load(boost::memory_order_acquire) < mCapacity)
+			break;
+		if (!block)
+			return false;
+		mNotFull.wait(lock);
+	}
+
+	if (!worker)
+		worker = mWorkers[mNextWorker.fetch_add(1, boost::memory_order_relaxed) % mWorkers.size()].get();
+	{
+		boost::unique_lock<boost::mutex> queueLock(worker->mutex);
+		worker->tasks.push_back(task);
+	}
+	mPending.fetch_add(1, boost::memory_order_release);
+	mIdle.notify_one();
+	return true;
+}
+
+
+/**
+ * Runs the remaining tasks, and stops the workers.
+ */
+void JvmExecutor::shutdown()
+{
+	if (isWorkerThread())
+		throw JNIException("JvmExecutor::shutdown: A worker can not shut down its own executor.");
+
+	{
+		boost::unique_lock<boost::mutex> lock(mIdleMutex);
+		if (mStopping)
+			return;
+		mStopping = true;
+		mIdle.notify_all();
+		mNotFull.notify_all();
+	}
+
+	for (size_t i = 0; i < mWorkers.size(); ++i)
+	{
+		if (mWorkers[i]->thread.joinable())
+			mWorkers[i]->thread.join();
+	}
+}
+
+
+/**
+ * Returns the number of workers.
+ */
+size_t JvmExecutor::size() const
+{
+	return mWorkers.size();
+}
+
+
+/**
+ * Returns the maximum number of queued tasks, or 0 if there is no limit.
+ */
+size_t JvmExecutor::capacity() const
+{
+	return mCapacity;
+}
+
+
+/**
+ * Returns true if the calling thread is a worker of this executor.
+ */
+bool JvmExecutor::isWorkerThread() const
+{
+	Worker* worker = static_cast<Worker*>(currentWorker.get());
+	return worker && worker->executor == this;
+}
+
+
+/**
+ * The body of a worker thread.
+ */
+void JvmExecutor::run(Worker* worker, bool daemon, const string& name)
+{
+	currentWorker.reset(worker);
+
+	string error;
+	try
+	{
+		attach(0, name.c_str(), daemon);
+	}
+	catch (std::exception& e)
+	{
+		error = e.what();
+		if (error.empty())
+			error = "Unknown error";
+	}
+
+	{
+		boost::unique_lock<boost::mutex> lock(mIdleMutex);
+		++mStartedCount;
+		if (mStartError.empty())
+			mStartError = error;
+		mStarted.notify_all();
+	}
+	if (!error.empty())
+	{
+		currentWorker.reset();
+		return;
+	}
+
+	try
+	{
+		while (true)
+		{
+			Task task;
+			if (take(worker, task))
+			{
+				if (mCapacity != 0)
+				{
+					boost::unique_lock<boost::mutex> lock(mIdleMutex);
+					mNotFull.notify_one();
+				}
+
+				// attach() only looks up the cached JNIEnv of this thread, unless the virtual machine was replaced.
+				try
+				{
+					execute(attach(), task);
+				}
+				catch (boost::thread_interrupted&)
+				{
+					throw;
+				}
+				catch (...)
+				{
+					// The virtual machine is shut down. Drop the task.
+				}
+				continue;
+			}
+
+			boost::unique_lock<boost::mutex> lock(mIdleMutex);
+			if (mPending.load(boost::memory_order_acquire) != 0)
+				continue;
+			if (mStopping)
+				break;
+			mIdle.wait(lock);
+		}
+	}
+	catch (boost::thread_interrupted&)
+	{
+		// The worker ends, as an interrupted boost::thread does. The other workers steal its tasks.
+		currentWorker.reset();
+		detach();
+		throw;
+	}
+
+	currentWorker.reset();
+	detach();
+}
+
+
+/**
+ * Takes the next task of the worker, stealing one from another worker if its queue is empty.
+ */
+bool JvmExecutor::take(Worker* worker, Task& task)
+{
+	{
+		// The most recently queued task is the most likely to still be in cache
+		boost::unique_lock<boost::mutex> lock(worker->mutex);
+		if (!worker->tasks.empty())
+		{
+			task.swap(worker->tasks.back());
+			worker->tasks.pop_back();
+			mPending.fetch_sub(1, boost::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// Steal the oldest task of another worker, starting with the next one
+	for (size_t i = 1; i < mWorkers.size(); ++i)
+	{
+		Worker* victim = mWorkers[(worker->index + i) % mWorkers.size()].get();
+		boost::unique_lock<boost::mutex> lock(victim->mutex);
+		if (!victim->tasks.empty())
+		{
+			task.swap(victim->tasks.front());
+			victim->tasks.pop_front();
+			mPending.fetch_sub(1, boost::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/**
+ * Runs a task inside a local reference frame.
+ */
+void JvmExecutor::execute(JNIEnv* env, const Task& task)
+{
+	// The workers never return to java, which would otherwise release the local references of a task
+	try
+	{
+		LocalFrame frame(env);
+		try
+		{
+			task(env);
+		}
+		catch (boost::thread_interrupted&)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			// Tasks report their own failures
+		}
+
+		if (env->ExceptionCheck())
+			env->ExceptionClear();
+	}
+	catch (JNIException&)
+	{
+		// The frame could not be allocated. Drop the task.
+	}
+}
+
+END_NAMESPACE(jace)
@@ -0,0 +1,97 @@
+#include "jace/LocalFrame.h"
+
+#include "jace/Jace.h"
+#include "jace/JNIException.h"
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	/**
+	 * Pushes a local frame, or throws a JNIException.
+	 */
+	void push(JNIEnv* env, jint capacity)
+	{
+		if (env->PushLocalFrame(capacity) != 0)
+		{
+			// The OutOfMemoryError left by PushLocalFrame() is reported as a JNIException instead
+			env->ExceptionClear();
+			THROW_JNI_EXCEPTION("LocalFrame: Unable to allocate a local frame.");
+		}
+	}
+} // namespace
+
+
+/**
+ * Pushes a frame on the current thread.
+ */
+LocalFrame::LocalFrame(jint capacity): mEnv(attach()), mPopped(false)
+{
+	push(mEnv, capacity);
+}
+
+
+/**
+ * Pushes a frame on the thread of the given JNIEnv.
+ */
+LocalFrame::LocalFrame(JNIEnv* env, jint capacity): mEnv(env), mPopped(false)
+{
+	push(mEnv, capacity);
+}
+
+
+/**
+ * Pops the frame, unless pop() has already been called.
+ */
+LocalFrame::~LocalFrame()
+{
+	if (!mPopped)
+		mEnv->PopLocalFrame(0);
+}
+
+
+/**
+ * Pops the frame, carrying result over to the enclosing frame.
+ */
+jobject LocalFrame::pop(jobject result)
+{
+	if (mPopped)
+		throw JNIException("LocalFrame::pop: The frame has already been popped.");
+
+	mPopped = true;
+	return mEnv->PopLocalFrame(result);
+}
+
+
+/**
+ * Returns the JNIEnv of the thread owning the frame.
+ */
+JNIEnv* LocalFrame::getEnv() const
+{
+	return mEnv;
+}
+
+
+/**
+ * Ensures that at least capacity more local references can be created in the current frame.
+ */
+void ensureLocalCapacity(JNIEnv* env, jint capacity)
+{
+	if (env->EnsureLocalCapacity(capacity) != 0)
+	{
+		env->ExceptionClear();
+		THROW_JNI_EXCEPTION("ensureLocalCapacity: Unable to allocate room for " + toString(capacity) +
+			" local references.");
+	}
+}
+
+
+/**
+ * Ensures that at least capacity more local references can be created in the current frame.
+ */
+void ensureLocalCapacity(jint capacity)
+{
+	ensureLocalCapacity(attach(), capacity);
+}
+
+END_NAMESPACE(jace)
@@ -0,0 +1,353 @@
+#include "jace/RefTracker.h"
+
+#include "jace/Jace.h"
+
+#include <map>
+using std::map;
+
+#include <ostream>
+using std::ostream;
+using std::endl;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <cstdlib>
+
+#include <boost/thread/mutex.hpp>
+
+#if defined(__GLIBC__)
+	#include <execinfo.h>
+	#define JACE_HAS_BACKTRACE
+#endif
+
+BEGIN_NAMESPACE(jace)
+
+namespace
+{
+	const int maxFrames = 16;
+
+	/**
+	 * A live global reference.
+	 */
+	struct Record
+	{
+		Record(): site(0), frameCount(0)
+		{}
+
+		RefTracker::Site* site;
+		int frameCount;
+		void* frames[maxFrames];
+	};
+
+	typedef map<string, RefTracker::Site> Sites;
+	typedef map<jobject, Record> Records;
+
+	/**
+	 * Guards the fields below.
+	 */
+	boost::mutex trackerMutex;
+	typedef boost::unique_lock<boost::mutex> auto_lock;
+
+	// The sites of each kind of reference, by name
+	Sites sites[2];
+	Records globalRecords;
+	size_t liveCount[2] = { 0, 0 };
+	size_t peakCount[2] = { 0, 0 };
+	bool captureBacktraces = false;
+
+	RefTracker::Site& getSite(RefTracker::Kind kind, const char* name)
+	{
+		Sites::iterator it = sites[kind].find(name);
+		if (it == sites[kind].end())
+		{
+			RefTracker::Site site;
+			site.name = name;
+			site.kind = kind;
+			it = sites[kind].insert(Sites::value_type(name, site)).first;
+		}
+		return it->second;
+	}
+
+	/**
+	 * Counts a new reference at a site.
+	 */
+	void increment(RefTracker::Kind kind, RefTracker::Site& site)
+	{
+		++site.created;
+		if (kind == RefTracker::Global && ++site.live > site.peak)
+			site.peak = site.live;
+		if (++liveCount[kind] > peakCount[kind])
+			peakCount[kind] = liveCount[kind];
+	}
+
+	/**
+	 * Returns the name of the class of a live reference, or an empty string if it can not be retrieved.
+	 *
+	 * Only makes raw JNI calls, which are not tracked, as the caller holds trackerMutex.
+	 */
+	string getClassName(JNIEnv* env, jmethodID getName, jobject ref)
+	{
+		jclass cls = env->GetObjectClass(ref);
+		jstring name = cls ? static_cast<jstring>(env->CallObjectMethod(cls, getName)) : 0;
+		env->DeleteLocalRef(cls);
+		if (!name)
+		{
+			env->ExceptionClear();
+			return string();
+		}
+
+		string result;
+		const char* utfName = env->GetStringUTFChars(name, 0);
+		if (utfName)
+		{
+			result = utfName;
+			env->ReleaseStringUTFChars(name, utfName);
+		}
+		env->DeleteLocalRef(name);
+		return result;
+	}
+
+	void writeSites(ostream& out, const char* title, const Sites& kindSites)
+	{
+		out << title << endl;
+		for (Sites::const_iterator it = kindSites.begin(); it != kindSites.end(); ++it)
+		{
+			const RefTracker::Site& site = it->second;
+			out << "  " << site.name << ": ";
+			if (site.kind == RefTracker::Global)
+				out << site.live << " live, " << site.peak << " peak, ";
+			out << site.created << " created" << endl;
+		}
+	}
+
+	void writeBacktrace(ostream& out, const Record& record)
+	{
+		#ifdef JACE_HAS_BACKTRACE
+			char** symbols = backtrace_symbols(record.frames, record.frameCount);
+			for (int i = 0; i < record.frameCount; ++i)
+				out << "      " << (symbols ? symbols[i] : "?") << endl;
+			free(symbols);
+		#else
+			(void) out;
+			(void) record;
+		#endif
+	}
+} // namespace
+
+
+/**
+ * Returns true if Jace was built with JACE_TRACK_REFS defined.
+ */
+bool RefTracker::isEnabled()
+{
+	#ifdef JACE_TRACK_REFS
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+
+/**
+ * Records the creation of a reference.
+ */
+void RefTracker::created(Kind kind, jobject ref, const char* site)
+{
+	if (!ref)
+		return;
+
+	auto_lock lock(trackerMutex);
+	Site& counts = getSite(kind, site);
+	if (kind == Local)
+	{
+		increment(kind, counts);
+		return;
+	}
+
+	Record& record = globalRecords[ref];
+	if (record.site)
+	{
+		// The virtual machine reused a reference that was deleted behind our back
+		--record.site->live;
+		--liveCount[Global];
+	}
+	record.site = &counts;
+	record.frameCount = 0;
+	#ifdef JACE_HAS_BACKTRACE
+		if (captureBacktraces)
+			record.frameCount = backtrace(record.frames, maxFrames);
+	#endif
+	increment(kind, counts);
+}
+
+
+/**
+ * Records the deletion of a reference.
+ */
+void RefTracker::deleted(Kind kind, jobject ref)
+{
+	if (!ref)
+		return;
+
+	auto_lock lock(trackerMutex);
+	if (kind == Local)
+	{
+		// Local references are only counted, so the deletion is charged to the total alone
+		if (liveCount[Local] > 0)
+			--liveCount[Local];
+		return;
+	}
+
+	Records::iterator it = globalRecords.find(ref);
+	if (it == globalRecords.end())
+		return;
+	--it->second.site->live;
+	--liveCount[Global];
+	globalRecords.erase(it);
+}
+
+
+/**
+ * Enables or disables capturing backtraces.
+ */
+void RefTracker::setCaptureBacktraces(bool enabled)
+{
+	auto_lock lock(trackerMutex);
+	captureBacktraces = enabled;
+}
+
+
+/**
+ * Returns the number of live references of a kind.
+ */
+size_t RefTracker::live(Kind kind)
+{
+	auto_lock lock(trackerMutex);
+	return liveCount[kind];
+}
+
+
+/**
+ * Returns the high-water mark of a kind of reference.
+ */
+size_t RefTracker::peak(Kind kind)
+{
+	auto_lock lock(trackerMutex);
+	return peakCount[kind];
+}
+
+
+/**
+ * Returns the call sites that created references.
+ */
+vector<RefTracker::Site> RefTracker::getSites()
+{
+	auto_lock lock(trackerMutex);
+	vector<Site> result;
+	for (int kind = Global; kind <= Local; ++kind)
+	{
+		for (Sites::const_iterator it = sites[kind].begin(); it != sites[kind].end(); ++it)
+			result.push_back(it->second);
+	}
+	return result;
+}
+
+
+/**
+ * Writes the accounting of every call site to out.
+ */
+void RefTracker::dump(ostream& out, size_t maxBacktraces)
+{
+	if (!isEnabled())
+	{
+		out << "RefTracker: Jace was built without JACE_TRACK_REFS, no references were tracked." << endl;
+		return;
+	}
+
+	JNIEnv* env = 0;
+	if (getJavaVm())
+	{
+		try
+		{
+			env = attach();
+		}
+		catch (VirtualMachineShutdownError&)
+		{
+		}
+	}
+
+	auto_lock lock(trackerMutex);
+	out << "RefTracker: " << liveCount[Global] << " global references live (" << peakCount[Global] << " peak), "
+		<< liveCount[Local] << " local references live (" << peakCount[Local] << " peak)" << endl;
+	writeSites(out, "Global references by call site:", sites[Global]);
+	writeSites(out, "Local references by call site:", sites[Local]);
+
+	if (!env || globalRecords.empty())
+		return;
+
+	jclass classClass = env->FindClass("java/lang/Class");
+	jmethodID getName = classClass ? env->GetMethodID(classClass, "getName", "()Ljava/lang/String;") : 0;
+	env->DeleteLocalRef(classClass);
+	if (!getName)
+	{
+		env->ExceptionClear();
+		return;
+	}
+
+	map<string, size_t> classes;
+	for (Records::const_iterator it = globalRecords.begin(); it != globalRecords.end(); ++it)
+		++classes[getClassName(env, getName, it->first)];
+
+	out << "Live global references by class:" << endl;
+	for (map<string, size_t>::const_iterator it = classes.begin(); it != classes.end(); ++it)
+		out << "  " << (it->first.empty() ? "<unknown>" : it->first) << ": " << it->second << endl;
+
+	size_t written = 0;
+	for (Records::const_iterator it = globalRecords.begin(); it != globalRecords.end() && written < maxBacktraces;
+		++it)
+	{
+		if (it->second.frameCount == 0)
+			continue;
+		out << "  Created at " << it->second.site->name << ", " << getClassName(env, getName, it->first) << ":"
+			<< endl;
+		writeBacktrace(out, it->second);
+		++written;
+	}
+}
+
+
+/**
+ * Writes a report to out if any global reference is live.
+ */
+size_t RefTracker::check(ostream& out)
+{
+	size_t count = live(Global);
+	if (count > 0)
+	{
+		out << "RefTracker: " << count << " global references are still live." << endl;
+		dump(out);
+	}
+	return count;
+}
+
+
+/**
+ * Forgets every reference and call site.
+ */
+void RefTracker::reset()
+{
+	auto_lock lock(trackerMutex);
+	globalRecords.clear();
+	for (int kind = Global; kind <= Local; ++kind)
+	{
+		sites[kind].clear();
+		liveCount[kind] = 0;
+		peakCount[kind] = 0;
+	}
+}
+
+END_NAMESPACE(jace)
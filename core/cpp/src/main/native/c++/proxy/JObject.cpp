@@ -5,6 +5,7 @@
 #include "jace/JConstructor.h"
 #include "jace/JMethod.h"
 #include "jace/JArguments.h"
+#include "jace/RefTracker.h"
 #include "jace/VirtualMachineShutdownError.h"
 
 #include <iostream>
@@ -14,14 +15,28 @@ using std::endl;
 #include <exception>
 using std::exception;
 
+#include <boost/atomic.hpp>
 #include <boost/thread/mutex.hpp>
 
 BEGIN_NAMESPACE_2(jace, proxy)
 
+/**
+ * A global reference, and the number of JObjects sharing it.
+ */
+class JObject::SharedRef
+{
+public:
+  explicit SharedRef(jobject _ref): ref(_ref), count(1)
+  {}
+
+  const jobject ref;
+  boost::atomic<size_t> count;
+};
+
 /**
  * Creates a new reference to an existing jvalue.
  */
-JObject::JObject(jvalue value)
+JObject::JObject(jvalue value): mShared(0)
 {
   setJavaJniValue(value);
 }
@@ -29,7 +44,7 @@ JObject::JObject(jvalue value)
 /**
  * Creates a new reference to an existing jobject.
  */
-JObject::JObject(jobject object)
+JObject::JObject(jobject object): mShared(0)
 {
   setJavaJniObject(object);
 }
@@ -40,7 +55,7 @@ JObject::JObject(jobject object)
  * All subclasses of JObject should provide this constructor
  * for their own subclasses.
  */
-JObject::JObject()
+JObject::JObject(): mShared(0)
 {
 }
 
@@ -49,10 +64,29 @@ JObject::JObject()
  *
  * @param object the object
  */
-JObject::JObject(const JObject& other)
+JObject::JObject(const JObject& other): mShared(0)
+{
+	shareJavaJniObject(other);
+}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+/**
+ * Takes over the reference of another object, which becomes a null reference.
+ */
+JObject::JObject(JObject&& other): mShared(0)
+{
+	moveJavaJniObject(other);
+}
+
+/**
+ * Takes over the reference of another object, which becomes a null reference.
+ */
+JObject& JObject::operator=(JObject&& other)
 {
-	JValue::setJavaJniValue(static_cast<jvalue>(other));
+	moveJavaJniObject(other);
+	return *this;
 }
+#endif
 
 /**
  * Destroys an object reference.
@@ -61,10 +95,7 @@ JObject::~JObject() throw ()
 {
 	try
 	{
-		jobject ref = *this;
-		if (ref) {
-			deleteGlobalRef(ref), ref = 0;
-		}
+		release();
 	}
 	catch (VirtualMachineShutdownError&)
 	{
@@ -112,8 +143,7 @@ bool JObject::isNull() const
 
 JObject& JObject::operator=(const JObject& object)
 {
-	// We don't check if (this == &object) because setJavaJniObject() already does
-  setJavaJniObject(static_cast<jobject>(object));
+  shareJavaJniObject(object);
   return *this;
 }
 
@@ -130,6 +160,88 @@ void JObject::setJavaJniObject(jobject object) {
 }
 
 
+/**
+ * Takes over the global reference of another object, which becomes a null reference.
+ */
+void JObject::moveJavaJniObject(JObject& other) {
+  if (&other == this)
+    return;
+
+  // A borrowed reference can not be taken over, the other object does not own it
+  if (!other.mShared) {
+    shareJavaJniObject(other);
+    return;
+  }
+
+  jvalue value = static_cast<jvalue>(other);
+  SharedRef* shared = other.mShared;
+  jvalue null;
+  null.l = 0;
+  other.JValue::setJavaJniValue(null);
+  other.mShared = 0;
+
+  release();
+  JValue::setJavaJniValue(value);
+  mShared = shared;
+}
+
+
+/**
+ * Shares the global reference of another object.
+ */
+void JObject::shareJavaJniObject(const JObject& other) {
+  if (!other.mShared) {
+    // A null or borrowed reference
+    setJavaJniValue(static_cast<jvalue>(other));
+    return;
+  }
+  if (other.mShared == mShared)
+    return;
+
+  // Retain the new reference before releasing ours, in case the old one is what keeps other alive
+  SharedRef* shared = other.mShared;
+  jvalue value = static_cast<jvalue>(other);
+  shared->count.fetch_add(1, boost::memory_order_relaxed);
+
+  release();
+  JValue::setJavaJniValue(value);
+  mShared = shared;
+}
+
+
+/**
+ * Sets the jobject for this JObject, without creating a global reference.
+ */
+void JObject::borrowJavaJniObject(jobject object) {
+  release();
+
+  jvalue value;
+  value.l = object;
+  JValue::setJavaJniValue(value);
+}
+
+
+/**
+ * Releases the reference of this object, deleting the global reference if no other object shares it.
+ */
+void JObject::release() {
+  SharedRef* shared = mShared;
+  jvalue null;
+  null.l = 0;
+  JValue::setJavaJniValue(null);
+  mShared = 0;
+
+  if (!shared || shared->count.fetch_sub(1, boost::memory_order_release) != 1)
+    return;
+
+  // Every other copy has released the reference, make their writes visible before it is deleted
+  boost::atomic_thread_fence(boost::memory_order_acquire);
+  jobject ref = shared->ref;
+  delete shared;
+  releaseGlobalRef(ref);
+}
+
+
 /**
  * This method sets the jobject for this JObject.
  *
@@ -147,21 +259,24 @@ void JObject::setJavaJniValue(jvalue newValue) {
       return;
   }
   jvalue ourCopy;
+  SharedRef* shared = 0;
 
   if (!newValue.l) {
       // If the new value is a null reference, we save time by not creating a new global reference.
       ourCopy = newValue;
   } else {
-      // Create our own global reference to the object
+      // Create our own global reference to the object, which our copies will share
       jobject object = env->NewGlobalRef(newValue.l);
+      JACE_REF_CREATED(Global, object, "JObject::setJavaJniValue");
       ourCopy.l = object;
+      if (object)
+          shared = new SharedRef(object);
   }
 
-	// Delete the old value
-  if (oldValue) {
-      env->DeleteGlobalRef(oldValue), oldValue = 0;
-  }
+	// Release the old value, which is only deleted if no copy shares it
+  release();
   JValue::setJavaJniValue(ourCopy);
+  mShared = shared;
 }
 
 /**
@@ -0,0 +1,339 @@
+#include "jace/runtime/BulkInvoker.h"
+
+#include "jace/Jace.h"
+#include "jace/JClassImpl.h"
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+using jace::JClass;
+using jace::JClassImpl;
+using jace::proxy::JObject;
+using jace::proxy::JValue;
+
+#include <string>
+using std::string;
+
+#include <cstring>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+BEGIN_NAMESPACE_2(jace, runtime)
+
+namespace
+{
+	const string invokerClassName = "org/jace/util/BulkInvoker";
+
+	boost::mutex invokerClassMutex;
+	const JClass& getInvokerClass()
+	{
+		static boost::shared_ptr<JClassImpl> result;
+		boost::mutex::scoped_lock lock(invokerClassMutex);
+		if (result == 0)
+			result = boost::shared_ptr<JClassImpl>(new JClassImpl(invokerClassName));
+		return *result;
+	}
+
+	/**
+	 * Reduces a JNI type descriptor to its type letter, treating arrays as objects.
+	 * Returns the position following the type.
+	 */
+	size_t parseType(const string& descriptor, size_t position, char& type)
+	{
+		size_t i = position;
+		while (i < descriptor.size() && descriptor[i] == '[')
+			++i;
+		if (i >= descriptor.size())
+			THROW_JNI_EXCEPTION("BulkInvoker: Invalid method descriptor <" + descriptor + ">");
+
+		if (descriptor[i] == 'L')
+		{
+			i = descriptor.find(';', i);
+			if (i == string::npos)
+				THROW_JNI_EXCEPTION("BulkInvoker: Invalid method descriptor <" + descriptor + ">");
+		}
+		type = (i == position) ? descriptor[i] : 'L';
+		return i + 1;
+	}
+} // namespace
+
+
+/**
+ * Binds the method with the given name and JNI descriptor.
+ */
+BulkInvoker::Target::Target(const JClass& jClass, const string& name, const string& descriptor, Kind kind):
+	mIndex(0), mParameters(), mResult('V')
+{
+	if (descriptor.empty() || descriptor[0] != '(')
+		THROW_JNI_EXCEPTION("BulkInvoker: Invalid method descriptor <" + descriptor + ">");
+
+	// The receiver is the first argument of a virtual method
+	if (kind == Virtual)
+		mParameters.push_back('L');
+
+	size_t position = 1;
+	while (position < descriptor.size() && descriptor[position] != ')')
+	{
+		char type;
+		position = parseType(descriptor, position, type);
+		mParameters.push_back(type);
+	}
+	parseType(descriptor, position + 1, mResult);
+	if (kind == Constructor)
+		mResult = 'L';
+
+	// Bind the method on the java side
+	JNIEnv* env = attach();
+	const JClass& invokerClass = getInvokerClass();
+	jmethodID bind = JMemberRegistry::getMethodID(invokerClass, "bind",
+		"(Ljava/lang/Class;Ljava/lang/String;Ljava/lang/String;I)I", true);
+	if (!bind)
+		THROW_JNI_EXCEPTION("Assert failed: Unable to find the method, BulkInvoker.bind().");
+
+	jstring javaName = env->NewStringUTF(name.c_str());
+	jstring javaDescriptor = env->NewStringUTF(descriptor.c_str());
+	if (!javaName || !javaDescriptor)
+	{
+		env->DeleteLocalRef(javaName), javaName = 0;
+		env->DeleteLocalRef(javaDescriptor), javaDescriptor = 0;
+		THROW_JNI_EXCEPTION("Assert failed: Error creating java string.");
+	}
+
+	mIndex = env->CallStaticIntMethod(invokerClass.getClass(), bind, jClass.getClass(), javaName, javaDescriptor,
+		static_cast<jint>(kind));
+	env->DeleteLocalRef(javaName), javaName = 0;
+	env->DeleteLocalRef(javaDescriptor), javaDescriptor = 0;
+	catchAndThrow();
+}
+
+
+/**
+ * Creates an empty batch.
+ */
+BulkInvoker::BulkInvoker(): mSlots(), mObjects(), mCalls(), mPendingArguments(0), mResults(0)
+{}
+
+
+/**
+ * Releases the results of the batch.
+ */
+BulkInvoker::~BulkInvoker()
+{
+	if (mResults)
+		deleteGlobalRef(mResults), mResults = 0;
+}
+
+
+/**
+ * Adds a call to the batch.
+ */
+BulkInvoker& BulkInvoker::add(const Target& target)
+{
+	checkComplete();
+
+	Call call;
+	call.target = &target;
+	call.slot = mSlots.size();
+	mCalls.push_back(call);
+
+	mSlots.push_back(target.mIndex);
+
+	// Reserve a place in the object array for reference results
+	if (target.mResult == 'L')
+	{
+		mSlots.push_back(static_cast<jlong>(mObjects.size()));
+		mObjects.push_back(0);
+	}
+	else
+		mSlots.push_back(0);
+
+	mPendingArguments = target.mParameters.size();
+	return *this;
+}
+
+
+/**
+ * Adds an argument to the last call of the batch.
+ */
+BulkInvoker& BulkInvoker::operator<<(const JValue& argument)
+{
+	if (mPendingArguments == 0)
+		THROW_JNI_EXCEPTION("BulkInvoker: Too many arguments for the call.");
+
+	const Call& call = mCalls.back();
+	const string& parameters = call.target->mParameters;
+	char type = parameters[parameters.size() - mPendingArguments];
+	--mPendingArguments;
+
+	jvalue value = argument;
+	jlong bits = 0;
+	switch (type)
+	{
+		case 'Z': bits = value.z; break;
+		case 'B': bits = value.b; break;
+		case 'C': bits = value.c; break;
+		case 'S': bits = value.s; break;
+		case 'I': bits = value.i; break;
+		case 'J': bits = value.j; break;
+		case 'F':
+		{
+			jint floatBits;
+			std::memcpy(&floatBits, &value.f, sizeof(floatBits));
+			bits = floatBits;
+			break;
+		}
+		case 'D':
+			std::memcpy(&bits, &value.d, sizeof(bits));
+			break;
+		default:
+			bits = static_cast<jlong>(mObjects.size());
+			mObjects.push_back(value.l);
+			break;
+	}
+	mSlots.push_back(bits);
+	return *this;
+}
+
+
+/**
+ * Returns the number of calls in the batch.
+ */
+size_t BulkInvoker::size() const
+{
+	return mCalls.size();
+}
+
+
+/**
+ * Executes every call of the batch with a single JNI call.
+ */
+void BulkInvoker::execute()
+{
+	checkComplete();
+	if (mCalls.empty())
+		return;
+
+	JNIEnv* env = attach();
+	const JClass& invokerClass = getInvokerClass();
+	jmethodID execute = JMemberRegistry::getMethodID(invokerClass, "execute",
+		"(Ljava/nio/ByteBuffer;I[Ljava/lang/Object;)V", true);
+	if (!execute)
+		THROW_JNI_EXCEPTION("Assert failed: Unable to find the method, BulkInvoker.execute().");
+
+	jobjectArray objects = env->NewObjectArray(static_cast<jsize>(mObjects.size()),
+		JObject::staticGetJavaJniClass().getClass(), 0);
+	if (!objects)
+	{
+		catchAndThrow();
+		THROW_JNI_EXCEPTION("BulkInvoker: Unable to allocate the object array.");
+	}
+	for (size_t i = 0; i < mObjects.size(); ++i)
+	{
+		if (mObjects[i])
+			env->SetObjectArrayElement(objects, static_cast<jsize>(i), mObjects[i]);
+	}
+
+	// The buffer wraps mSlots, so the results are written straight back into it
+	jobject buffer = env->NewDirectByteBuffer(&mSlots[0], static_cast<jlong>(mSlots.size() * sizeof(jlong)));
+	if (!buffer)
+	{
+		env->DeleteLocalRef(objects), objects = 0;
+		catchAndThrow();
+		THROW_JNI_EXCEPTION("BulkInvoker: Unable to allocate a direct buffer.");
+	}
+
+	env->CallStaticVoidMethod(invokerClass.getClass(), execute, buffer, static_cast<jint>(mCalls.size()), objects);
+	env->DeleteLocalRef(buffer), buffer = 0;
+
+	// The results of the previous batch are stale either way
+	if (mResults)
+		deleteGlobalRef(env, mResults), mResults = 0;
+
+	// No new reference may be created while an exception is pending
+	if (env->ExceptionCheck())
+	{
+		env->DeleteLocalRef(objects), objects = 0;
+		catchAndThrow(env);
+	}
+
+	// Keep the object array, it holds the reference results
+	mResults = static_cast<jobjectArray>(newGlobalRef(env, objects));
+	env->DeleteLocalRef(objects), objects = 0;
+}
+
+
+/**
+ * Returns the result of the given call, for methods returning a primitive type.
+ */
+jvalue BulkInvoker::getResult(size_t call) const
+{
+	const Call& c = mCalls.at(call);
+	jlong bits = mSlots[c.slot + 1];
+
+	jvalue value;
+	value.j = 0;
+	switch (c.target->mResult)
+	{
+		case 'Z': value.z = bits != 0 ? JNI_TRUE : JNI_FALSE; break;
+		case 'B': value.b = static_cast<jbyte>(bits); break;
+		case 'C': value.c = static_cast<jchar>(bits); break;
+		case 'S': value.s = static_cast<jshort>(bits); break;
+		case 'I': value.i = static_cast<jint>(bits); break;
+		case 'J': value.j = bits; break;
+		case 'F':
+		{
+			jint floatBits = static_cast<jint>(bits);
+			std::memcpy(&value.f, &floatBits, sizeof(floatBits));
+			break;
+		}
+		case 'D':
+			std::memcpy(&value.d, &bits, sizeof(bits));
+			break;
+		case 'L':
+			THROW_JNI_EXCEPTION("BulkInvoker: The call returns an object, use getObjectResult().");
+		default:
+			break;
+	}
+	return value;
+}
+
+
+/**
+ * Returns the result of the given call, for methods returning an object and for constructors.
+ */
+JObject BulkInvoker::getObjectResult(size_t call) const
+{
+	const Call& c = mCalls.at(call);
+	if (c.target->mResult != 'L')
+		THROW_JNI_EXCEPTION("BulkInvoker: The call does not return an object, use getResult().");
+	if (!mResults)
+		THROW_JNI_EXCEPTION("BulkInvoker: The batch has not been executed.");
+
+	JNIEnv* env = attach();
+	jobject result = env->GetObjectArrayElement(mResults, static_cast<jsize>(mSlots[c.slot + 1]));
+	JObject returnVal(result);
+	env->DeleteLocalRef(result), result = 0;
+	return returnVal;
+}
+
+
+/**
+ * Removes all calls and results.
+ */
+void BulkInvoker::clear()
+{
+	mSlots.clear();
+	mObjects.clear();
+	mCalls.clear();
+	mPendingArguments = 0;
+	if (mResults)
+		deleteGlobalRef(mResults), mResults = 0;
+}
+
+
+void BulkInvoker::checkComplete() const
+{
+	if (mPendingArguments != 0)
+		THROW_JNI_EXCEPTION("BulkInvoker: The last call is missing arguments.");
+}
+
+END_NAMESPACE_2(jace, runtime)
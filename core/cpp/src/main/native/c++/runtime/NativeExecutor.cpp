@@ -0,0 +1,192 @@
+#include "jace/runtime/NativeExecutor.h"
+
+#include "jace/Jace.h"
+#include "jace/JClassImpl.h"
+#include "jace/JNIException.h"
+#include "jace/JMemberRegistry.h"
+using jace::JClassImpl;
+using jace::JMemberRegistry;
+using jace::JvmExecutor;
+using jace::proxy::JObject;
+
+#include "jace/runtime/NativeProxy.h"
+
+#include <string>
+using std::string;
+
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+BEGIN_NAMESPACE_2(jace, runtime)
+
+namespace
+{
+	/**
+	 * The classes used by the workers, which are only loaded once.
+	 */
+	struct Classes
+	{
+		Classes():
+			runnable("java/lang/Runnable"),
+			thread("java/lang/Thread"),
+			handler("java/lang/Thread$UncaughtExceptionHandler"),
+			service("org/jace/util/NativeExecutorService")
+		{}
+
+		JClassImpl runnable;
+		JClassImpl thread;
+		JClassImpl handler;
+		JClassImpl service;
+	};
+
+	boost::mutex classesMutex;
+	const Classes& getClasses()
+	{
+		static boost::shared_ptr<Classes> result;
+		boost::mutex::scoped_lock lock(classesMutex);
+		if (result == 0)
+			result = boost::shared_ptr<Classes>(new Classes);
+		return *result;
+	}
+
+	/**
+	 * Passes an exception thrown by a Runnable to the uncaught exception handler of the current thread.
+	 */
+	void reportUncaught(JNIEnv* env, jthrowable error)
+	{
+		const Classes& classes = getClasses();
+		jmethodID currentThread = JMemberRegistry::getMethodID(classes.thread, "currentThread",
+			"()Ljava/lang/Thread;", true);
+		jmethodID getHandler = JMemberRegistry::getMethodID(classes.thread, "getUncaughtExceptionHandler",
+			"()Ljava/lang/Thread$UncaughtExceptionHandler;");
+		jmethodID uncaughtException = JMemberRegistry::getMethodID(classes.handler, "uncaughtException",
+			"(Ljava/lang/Thread;Ljava/lang/Throwable;)V");
+		if (!currentThread || !getHandler || !uncaughtException)
+		{
+			env->ExceptionClear();
+			return;
+		}
+
+		jobject thread = env->CallStaticObjectMethod(classes.thread.getClass(), currentThread);
+		jobject handler = thread ? env->CallObjectMethod(thread, getHandler) : 0;
+		if (handler)
+			env->CallVoidMethod(handler, uncaughtException, thread, error);
+
+		// Exceptions thrown by the handler are ignored, as they are by java threads
+		if (env->ExceptionCheck())
+			env->ExceptionClear();
+		if (handler)
+			env->DeleteLocalRef(handler);
+		if (thread)
+			env->DeleteLocalRef(thread);
+	}
+
+	/**
+	 * Runs a Runnable on a worker.
+	 */
+	void run(JNIEnv* env, const JObject& runnable)
+	{
+		jmethodID method = JMemberRegistry::getMethodID(getClasses().runnable, "run", "()V");
+		if (!method)
+		{
+			env->ExceptionClear();
+			return;
+		}
+
+		env->CallVoidMethod(static_cast<jobject>(runnable), method);
+		jthrowable error = env->ExceptionOccurred();
+		if (error)
+		{
+			env->ExceptionClear();
+			reportUncaught(env, error);
+			env->DeleteLocalRef(error);
+		}
+	}
+
+	/**
+	 * Implements Executor.execute(command), for the proxies returned by createExecutor().
+	 * The context of the proxy is the JvmExecutor.
+	 */
+	jobject execute(JNIEnv* env, JACE_NATIVE_CALLBACK_ARGS)
+	{
+		// The proxy itself is not needed, only its context
+		(void) obj;
+		JvmExecutor* executor = reinterpret_cast<JvmExecutor*>(NativeProxy::getContext());
+		jobject command = env->GetObjectArrayElement(static_cast<jobjectArray>(static_cast<jobject>(args)), 0);
+		if (!command)
+		{
+			java_throw("java/lang/NullPointerException", "command");
+			return 0;
+		}
+
+		try
+		{
+			JObject runnable(command);
+			env->DeleteLocalRef(command);
+			if (!executor->trySubmit(boost::bind(&run, _1, runnable)))
+				java_throw("java/util/concurrent/RejectedExecutionException", "The executor is at capacity");
+		}
+		catch (std::exception& e)
+		{
+			java_throw("java/util/concurrent/RejectedExecutionException", e.what());
+		}
+		return 0;
+	}
+
+	/**
+	 * Returns the Builder of the Executor proxies.
+	 *
+	 * The Builder is shared by every proxy, and never deleted, because java may call
+	 * a proxy at any time until it is garbage collected.
+	 */
+	NativeProxy::Builder& getBuilder()
+	{
+		static boost::mutex mutex;
+		static NativeProxy::Builder* builder = 0;
+
+		boost::mutex::scoped_lock lock(mutex);
+		if (!builder)
+		{
+			NativeProxy::Builder* newBuilder = new NativeProxy::Builder("java.util.concurrent.Executor");
+			newBuilder->registerCallback("execute", NativeProxy::Callback(&execute));
+			builder = newBuilder;
+		}
+		return *builder;
+	}
+} // namespace
+
+
+/**
+ * Returns a java.util.concurrent.Executor that runs its Runnables on the workers of a JvmExecutor.
+ */
+JObject createExecutor(JvmExecutor& executor)
+{
+	return getBuilder().build<JObject>(reinterpret_cast<jlong>(&executor));
+}
+
+
+/**
+ * Returns a java.util.concurrent.ExecutorService that runs its tasks on the workers of a JvmExecutor.
+ */
+JObject createExecutorService(JvmExecutor& executor)
+{
+	JObject proxy = createExecutor(executor);
+
+	JNIEnv* env = attach();
+	const JClassImpl& serviceClass = getClasses().service;
+	jmethodID constructor = JMemberRegistry::getMethodID(serviceClass, "<init>", "(Ljava/util/concurrent/Executor;)V");
+	if (!constructor)
+		THROW_JNI_EXCEPTION("Assert failed: Unable to find the constructor, NativeExecutorService(Executor).");
+
+	jobject service = env->NewObject(serviceClass.getClass(), constructor, static_cast<jobject>(proxy));
+	catchAndThrow(env);
+	if (!service)
+		THROW_JNI_EXCEPTION("Assert failed: Error instantiating NativeExecutorService.");
+
+	JObject result(service);
+	env->DeleteLocalRef(service);
+	return result;
+}
+
+END_NAMESPACE_2(jace, runtime)
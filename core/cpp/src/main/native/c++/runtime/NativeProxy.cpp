@@ -8,8 +8,13 @@ using std::string;
 using jace::JArguments;
 #include "jace/JMethod.h"
 using jace::JMethod;
+#include "jace/JMemberRegistry.h"
+using jace::JMemberRegistry;
+#include "jace/LocalFrame.h"
+using jace::LocalFrame;
 
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 
 BEGIN_NAMESPACE_3(jace, runtime, NativeProxy)
 
@@ -18,12 +23,67 @@ bool registered = false;
 boost::mutex regMtx;
 typedef boost::unique_lock<boost::mutex> auto_lock;
 
+/** The internal name of org.jace.util.NativeInvocation */
+const string nativeInvocationClass = "org/jace/util/NativeInvocation";
+
+/** The context of the callback running on the current thread, if any. Points into the stack of the callback. */
+static void noCleanup(jlong*) {}
+boost::thread_specific_ptr<jlong> currentContext(noCleanup);
+
+/**
+ * Runs a callback inside its own local frame, so that the local references it creates are
+ * released together when it returns, rather than when the java caller's native frame ends.
+ * C++ exceptions are rethrown in java, as they can not cross the JNI boundary.
+ */
+static jobject invokeInFrame(JNIEnv* env, const Callback& callback, jclass cls, jobject obj, jobjectArray args) {
+    try {
+        LocalFrame frame(env);
+        return frame.pop(callback(env, cls, obj, args));
+    } catch (::jace::proxy::JObject& e) {
+        // A java exception, thrown by a java method the callback called
+        env->Throw(static_cast<jthrowable>(static_cast<jobject>(e)));
+    } catch (std::exception& e) {
+        ::jace::java_throw("java/lang/RuntimeException", 
+                           std::string("Exception during native execution: ") + e.what());
+    } catch (...) {
+        ::jace::java_throw("java/lang/RuntimeException", "Unknown exception during native execution");
+    }
+    return 0;
+}
+
 /**
  * Invoked by org.jace.util.NativeInvocation.
  */
 static jobject native_invokeNative(JNIEnv* env, jclass cls, jlong ref, jint idx, jobject obj, jobjectArray args) {
     Builder*    pBuilder = (Builder*) ref;
-    return pBuilder->get(idx)(env, cls, obj, args);
+    return invokeInFrame(env, pBuilder->get(idx), cls, obj, args);
+}
+
+/**
+ * Restores the context of an enclosing callback, if any, once a callback returns.
+ */
+class ContextScope : public boost::noncopyable {
+public:
+    explicit ContextScope(jlong* context) : m_previous(currentContext.get()) { currentContext.reset(context); }
+    ~ContextScope() { currentContext.reset(m_previous); }
+private:
+    jlong*  m_previous;
+};
+
+/**
+ * Invoked by org.jace.util.NativeInvocation, for proxies that were built with a context.
+ */
+static jobject native_invokeNativeWithContext(JNIEnv* env, jclass cls, jlong ref, jint idx, jlong context,
+                                              jobject obj, jobjectArray args) {
+    Builder*    pBuilder = (Builder*) ref;
+    ContextScope scope(&context);
+    return invokeInFrame(env, pBuilder->get(idx), cls, obj, args);
+}
+
+/** Implementation of getContext() */
+jlong getContext() {
+    jlong* context = currentContext.get();
+    return context ? *context : 0;
 }
 
 /**
@@ -40,10 +100,14 @@ static void registerInvokeNativeHook() {
     }
 
     jobject(*pf)(JNIEnv*, jclass, jlong, jint, jobject, jobjectArray) = native_invokeNative;
+    jobject(*pfc)(JNIEnv*, jclass, jlong, jint, jlong, jobject, jobjectArray) = native_invokeNativeWithContext;
     JNINativeMethod methods[] = { 
         { (char*) "invokeNative", 
           (char*) "(JILjava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;", 
-          *(void**)(&pf) } 
+          *(void**)(&pf) },
+        { (char*) "invokeNativeWithContext", 
+          (char*) "(JIJLjava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;", 
+          *(void**)(&pfc) } 
     };
     int methods_size = sizeof(methods) / sizeof(methods[0]);
     if (env->RegisterNatives(hookClass, methods, methods_size) != JNI_OK) {
@@ -66,19 +130,29 @@ Builder::Builder(const std::string& className) {
         THROW_JNI_EXCEPTION("Assert failed: Unable to find the class, org.jace.util.NativeInvocation.");
     }
     
-	m_registerCallbackMethod = env->GetMethodID(instClass, "registerNative", "(Ljava/lang/String;JI)V");
+	m_registerCallbackMethod = JMemberRegistry::getMethodID(instClass, nativeInvocationClass, "registerNative",
+		"(Ljava/lang/String;JI)V");
 	if (!m_registerCallbackMethod) {
 		env->DeleteLocalRef(instClass), instClass = 0;
         THROW_JNI_EXCEPTION("Assert failed: Unable to find the method, NativeInvocation.registerNative().");
 	}
     
-    m_createProxyMethod = env->GetMethodID(instClass, "createProxy", "()Ljava/lang/Object;");
+    m_createProxyMethod = JMemberRegistry::getMethodID(instClass, nativeInvocationClass, "createProxy",
+		"()Ljava/lang/Object;");
 	if (!m_createProxyMethod) {
 		env->DeleteLocalRef(instClass), instClass = 0;
         THROW_JNI_EXCEPTION("Assert failed: Unable to find the method, NativeInvocation.createProxy().");
 	}
     
-    jmethodID constructor = env->GetMethodID(instClass, "<init>", "(Ljava/lang/String;)V");
+    m_createProxyWithContextMethod = JMemberRegistry::getMethodID(instClass, nativeInvocationClass, "createProxy",
+		"(J)Ljava/lang/Object;");
+	if (!m_createProxyWithContextMethod) {
+		env->DeleteLocalRef(instClass), instClass = 0;
+        THROW_JNI_EXCEPTION("Assert failed: Unable to find the method, NativeInvocation.createProxy(long).");
+	}
+    
+    jmethodID constructor = JMemberRegistry::getMethodID(instClass, nativeInvocationClass, "<init>",
+		"(Ljava/lang/String;)V");
 	if (!constructor) {
 		env->DeleteLocalRef(instClass), instClass = 0;
         THROW_JNI_EXCEPTION("Assert failed: Unable to find the constructor, NativeInvocation().");
@@ -97,6 +171,8 @@ Builder::Builder(const std::string& className) {
         THROW_JNI_EXCEPTION("Assert failed: Error instantiating object.");
     }
     
+    // Builders are typically kept for the life of the process, so their references are created
+    // through raw JNI, which RefTracker does not count as leaks
     m_instance = env->NewGlobalRef(instance);
     env->DeleteLocalRef(instance), instance = 0;
     m_classRef = static_cast<jclass>(env->NewGlobalRef(instClass));
@@ -141,4 +217,16 @@ void Builder::registerCallback(const std::string& name, const Callback& callback
     return returnVal;
 }
 
+::jace::proxy::JObject Builder::instantiate(jlong context) {
+    JNIEnv* env = attach();
+    jobject obj = env->CallObjectMethod(m_instance, m_createProxyWithContextMethod, context);
+    if (!obj) {
+        THROW_JNI_EXCEPTION("Exception thrown invoking NativeInvocation.createProxy(long)");
+    }
+
+    ::jace::proxy::JObject returnVal(obj);
+    env->DeleteLocalRef(obj), obj = 0;
+    return returnVal;
+}
+
 END_NAMESPACE_3(jace, runtime, NativeProxy)
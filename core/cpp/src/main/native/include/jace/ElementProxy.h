@@ -79,7 +79,7 @@ public:
 
 
 	~ElementProxy() throw () {
-        deleteGlobalRef(parent), parent = 0;
+        releaseGlobalRef(parent), parent = 0;
 	}
 
 private:
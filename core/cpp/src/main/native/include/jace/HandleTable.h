@@ -0,0 +1,250 @@
+#ifndef JACE_HANDLE_TABLE_H
+#define JACE_HANDLE_TABLE_H
+
+#include "jace/Namespace.h"
+#include "jace/Jace.h"
+#include "jace/Local.h"
+#include "jace/proxy/JObject.h"
+
+#include <jni.h>
+
+#include <vector>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A table of java objects, addressed from C++ by 32-bit handles.
+ *
+ * Each proxy owns a JNI global reference, and the virtual machine scans every global reference
+ * on each garbage collection. Native data structures that keep millions of java objects can
+ * store them in a HandleTable instead, and keep their handles. The objects live in a java array
+ * inside org.jace.util.HandleTable, so the virtual machine only sees the one global reference
+ * to the table.
+ *
+ * For example:
+ *
+ *   HandleTable table;
+ *   HandleTable::Handle handle = table.add(node);
+ *   ...
+ *   LocalFrame frame(env);
+ *   Local<Node> node = table.get<Node>(env, handle);
+ *   node.visit();
+ *   ...
+ *   table.remove(handle);
+ *
+ * Handles are only valid for the table that created them, until they are removed. The handle
+ * of a removed object may be given to another object.
+ *
+ * HandleTable is thread-safe.
+ */
+class HandleTable
+{
+public:
+	/**
+	 * A handle to an object in the table. 0 stands for null.
+	 */
+	typedef jint Handle;
+
+	/**
+	 * Creates an empty table, with room for capacity objects.
+	 *
+	 * @throws JNIException if the table cannot be created.
+	 */
+	explicit HandleTable(jint capacity = 64);
+
+	/**
+	 * Adds an object to the table.
+	 *
+	 * @return the handle of the object, or 0 if the object is null.
+	 */
+	Handle add(const ::jace::proxy::JObject& object);
+
+	/**
+	 * Adds an object to the table.
+	 *
+	 * @return the handle of the object, or 0 if object is null.
+	 */
+	Handle add(JNIEnv* env, jobject object);
+
+	/**
+	 * Adds several objects to the table, with a single call into java.
+	 *
+	 * @param objects the objects, which may be null
+	 * @param count the number of objects
+	 * @param handles receives the handles of the objects, 0 for nulls
+	 */
+	void add(JNIEnv* env, const jobject* objects, size_t count, Handle* handles);
+
+	/**
+	 * Adds several objects to the table, with a single call into java.
+	 *
+	 * @return the handles of the objects, 0 for nulls
+	 */
+	std::vector<Handle> add(JNIEnv* env, const std::vector<jobject>& objects);
+
+	/**
+	 * Returns a new local reference to the object of a handle, or null if handle is 0.
+	 *
+	 * @throws the java IllegalArgumentException if the handle is not in the table.
+	 */
+	jobject get(JNIEnv* env, Handle handle) const;
+
+	/**
+	 * Returns a Local proxy for the object of a handle, or a null proxy if handle is 0.
+	 *
+	 * The Local borrows a new local reference, which lives until the current local frame is popped.
+	 *
+	 * @throws the java IllegalArgumentException if the handle is not in the table.
+	 */
+	template <class T> Local<T> get(JNIEnv* env, Handle handle) const
+	{
+		return Local<T>(get(env, handle));
+	}
+
+	/**
+	 * Returns new local references to the objects of several handles, with a single call into java.
+	 *
+	 * @param handles the handles, which may be 0
+	 * @param count the number of handles
+	 * @param objects receives the local references, null for zeros
+	 * @throws the java IllegalArgumentException if a handle is not in the table.
+	 */
+	void get(JNIEnv* env, const Handle* handles, size_t count, jobject* objects) const;
+
+	/**
+	 * Removes the object of a handle from the table. A handle of 0 is ignored.
+	 *
+	 * @throws the java IllegalArgumentException if the handle is not in the table.
+	 */
+	void remove(Handle handle);
+
+	/**
+	 * Removes the object of a handle from the table. A handle of 0 is ignored.
+	 *
+	 * @throws the java IllegalArgumentException if the handle is not in the table.
+	 */
+	void remove(JNIEnv* env, Handle handle);
+
+	/**
+	 * Removes the objects of several handles from the table, with a single call into java.
+	 * Handles of 0 are ignored.
+	 *
+	 * @throws the java IllegalArgumentException if a handle is not in the table.
+	 */
+	void remove(JNIEnv* env, const Handle* handles, size_t count);
+
+	/**
+	 * Removes the objects of several handles from the table, with a single call into java.
+	 * Handles of 0 are ignored.
+	 *
+	 * @throws the java IllegalArgumentException if a handle is not in the table.
+	 */
+	void remove(JNIEnv* env, const std::vector<Handle>& handles);
+
+	/**
+	 * Removes every object from the table, invalidating every handle.
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of objects in the table.
+	 */
+	jint size() const;
+
+	/**
+	 * Returns the java table.
+	 */
+	const ::jace::proxy::JObject& getTable() const;
+
+private:
+	::jace::proxy::JObject mTable;
+};
+
+
+/**
+ * A handle to an object in a HandleTable, resolved to a local reference on use.
+ *
+ * A TableRef is the size of a pointer and a handle, and makes no JNI call when it is created,
+ * copied or destroyed. The object stays in the table until it is removed with release().
+ *
+ * For example:
+ *
+ *   std::vector< TableRef<Node> > nodes;
+ *   nodes.push_back(TableRef<Node>(table, node));
+ *   ...
+ *   Local<Node> node = nodes[i].get(env);
+ */
+template <class T> class TableRef
+{
+public:
+	/**
+	 * Creates a null reference.
+	 */
+	TableRef(): mTable(0), mHandle(0)
+	{}
+
+	/**
+	 * Adds an object to a table, and refers to it.
+	 */
+	TableRef(HandleTable& table, const T& object): mTable(&table), mHandle(table.add(object))
+	{}
+
+	/**
+	 * Refers to an object already in a table.
+	 */
+	TableRef(HandleTable& table, HandleTable::Handle handle): mTable(&table), mHandle(handle)
+	{}
+
+	/**
+	 * Returns a Local proxy for the object, which lives until the current local frame is popped.
+	 */
+	Local<T> get(JNIEnv* env) const
+	{
+		return mTable ? mTable->get<T>(env, mHandle) : Local<T>(0);
+	}
+
+	/**
+	 * Returns a Local proxy for the object, which lives until the current local frame is popped.
+	 */
+	Local<T> get() const
+	{
+		return get(attach());
+	}
+
+	/**
+	 * Removes the object from its table, and makes this reference null.
+	 * Copies of this reference must not be used afterwards.
+	 */
+	void release()
+	{
+		if (mTable)
+			mTable->remove(mHandle);
+		mTable = 0;
+		mHandle = 0;
+	}
+
+	/**
+	 * Returns true if the reference is null.
+	 */
+	bool isNull() const
+	{
+		return mHandle == 0;
+	}
+
+	/**
+	 * Returns the handle of the object.
+	 */
+	HandleTable::Handle getHandle() const
+	{
+		return mHandle;
+	}
+
+private:
+	HandleTable* mTable;
+	HandleTable::Handle mHandle;
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_HANDLE_TABLE_H
@@ -4,18 +4,29 @@
 #include "jace/Namespace.h"
 #include "jace/proxy/JValue.h"
 
+#include <jni.h>
+
 #include <list>
+#include <vector>
 
 BEGIN_NAMESPACE(jace)
 
 /**
  * Represents the list of arguments for a java method.
  *
+ * Up to InlineCapacity arguments are stored inside the JArguments itself,
+ * so building an argument list for a typical method does not allocate.
+ *
  * @author Toby Reyelts
  */
 class JArguments
 {
 public:
+	/**
+	 * The number of arguments that are stored without allocating.
+	 */
+	enum { InlineCapacity = 10 };
+
 	/**
 	 * Constructs a new argument list.
 	 */
@@ -51,13 +62,59 @@ public:
 	 */
 	JArguments& operator<<(const ::jace::proxy::JValue& value);
 
+	/**
+	 * Returns the number of arguments.
+	 */
+	size_t size() const;
+
+	/**
+	 * Returns the arguments, in order, as a contiguous array of size() JValue*'s.
+	 */
+	const ::jace::proxy::JValue* const* values() const;
+
 	/**
 	 * Returns this JArguments as a list of JValue*'s.
+	 *
+	 * This copies the arguments, use size() and values() instead.
 	 */
 	std::list<const ::jace::proxy::JValue*> asList() const;
 
 private:
-	std::list<const ::jace::proxy::JValue*> mList;
+	const ::jace::proxy::JValue* mInline[InlineCapacity];
+	std::vector<const ::jace::proxy::JValue*> mOverflow;
+	size_t mSize;
+};
+
+
+/**
+ * The jvalues of a JArguments, as passed to the JNI Call<Type>MethodA functions.
+ *
+ * The jvalues live on the stack, unless there are more than
+ * JArguments::InlineCapacity of them.
+ */
+class JArgumentValues
+{
+public:
+	/**
+	 * Converts the given arguments to jvalues.
+	 */
+	explicit JArgumentValues(const JArguments& arguments);
+
+	/**
+	 * Returns the jvalues. The result is never null, even if there are no arguments.
+	 */
+	jvalue* get();
+
+private:
+	/**
+	 * Prevent copying.
+	 */
+	JArgumentValues(const JArgumentValues&);
+	JArgumentValues& operator=(const JArgumentValues&);
+
+	jvalue mInline[JArguments::InlineCapacity];
+	std::vector<jvalue> mOverflow;
+	jvalue* mValues;
 };
 
 
@@ -7,6 +7,8 @@
 #include "jace/ElementProxy.h"
 #include "jace/JArrayHelper.h"
 #include "jace/JNIException.h"
+#include "jace/JTypeKind.h"
+#include "jace/LocalFrame.h"
 #include "jace/proxy/types/JBoolean.h"
 #include "jace/proxy/types/JByte.h"
 #include "jace/proxy/types/JChar.h"
@@ -101,11 +103,14 @@ public:
 	 */
 	template <class T> JArray(const std::vector<T>& values): JObject(0)
 	{
+		JNIEnv* env = attach();
+
+		// Releases the array, and any local reference left by the element conversions, at once
+		LocalFrame frame(env);
 		jobjectArray localArray = ::jace::JArrayHelper::newArray(values.size(), ElementType::staticGetJavaJniClass());
 		this->setJavaJniObject(localArray);
 
 		int i = 0;
-		JNIEnv* env = attach();
 
 		for (typename std::vector<T>::const_iterator it = values.begin(); it != values.end(); ++it, ++i)
 		{
@@ -113,14 +118,24 @@ public:
 			catchAndThrow();
 		}
 		_length = values.size();
-		env->DeleteLocalRef(localArray), localArray = 0;
 	}
 
 	JArray(const JArray& array): JObject(0)
 	{
-		this->setJavaJniObject(array);
+		this->shareJavaJniObject(array);
+		this->_length = array._length;
+	}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+	/**
+	 * Takes over the reference of another array, which becomes a null reference.
+	 */
+	JArray(JArray&& array): JObject(0)
+	{
+		this->moveJavaJniObject(array);
 		this->_length = array._length;
 	}
+#endif
 
 	/**
 	 * Destroys this JArray.
@@ -195,6 +210,47 @@ public:
 	}
 
 
+	/**
+	 * Retrieves the length of the array, through the given JNIEnv,
+	 * which must belong to the current thread.
+	 */
+	::jace::proxy::types::JInt length(JNIEnv* env) const
+	{
+		#ifdef JACE_CHECK_NULLS
+			if (!static_cast<jobject>(*this))
+				throw ::jace::JNIException("[JArray::length] Can not retrieve the length of a null array.");
+		#endif
+
+		if (_length == -1)
+			_length = ::jace::JArrayHelper::getLength(env, static_cast<jobject>(*this));
+		return _length;
+	}
+
+
+	/**
+	 * Retrieves the element at the given index of the array, through
+	 * the given JNIEnv, which must belong to the current thread.
+	 *
+	 * Equivalent to operator[], for callers that already hold the JNIEnv.
+	 *
+	 * @throw ArrayIndexOutOfBoundsException if the index
+	 * is outside of the range of the array.
+	 */
+	ElementProxy<ElementType> get(JNIEnv* env, int index)
+	{
+		return getElement(env, index);
+	}
+
+	/**
+	 * An overloaded version of get() that works for const
+	 * instances of JArray.
+	 */
+	const ElementProxy<ElementType> get(JNIEnv* env, int index) const
+	{
+		return getElement(env, index);
+	}
+
+
 	/**
 	 * Returns the JClass for this instance.
 	 *
@@ -475,6 +531,31 @@ public:
 			return Iterator(this, length(), length());
 		}
 private:
+	enum { Kind = JTypeKindOf<ElementType>::value };
+
+	/**
+	 * Implements get(JNIEnv*, int) for every element type, through the JTypeKind of ElementType.
+	 */
+	ElementProxy<ElementType> getElement(JNIEnv* env, int index) const
+	{
+		#ifdef JACE_CHECK_NULLS
+			if (!static_cast<jobject>(*this))
+				throw ::jace::JNIException("[JArray::get] Can not dereference a null array.");
+		#endif
+
+		#ifdef JACE_CHECK_ARRAYS
+			if (index >= length(env))
+				throw ::jace::JNIException("[JArray::get] invalid array index.");
+		#endif
+
+		jvalue value = ::jace::JArrayHelper::getElement(env, static_cast<JTypeKind>(Kind),
+			static_cast<jobject>(*this), index);
+		ElementProxy<ElementType> element(this->getJavaJniArray(), value, index);
+		if (static_cast<JTypeKind>(Kind) == ObjectKind)
+			deleteLocalRef(env, value.l), value.l = 0;
+		return element;
+	}
+
 	/**
 	 * Disallow operator= for now.
 	 */
@@ -5,6 +5,7 @@
 #include "jace/proxy/JObject.h"
 #include "jace/JClass.h"
 #include "jace/proxy/types/JInt.h"
+#include "jace/JTypeKind.h"
 
 #include "jni.h"
 
@@ -14,6 +15,20 @@ jobjectArray newArray(int size, const jace::JClass& elementClass);
 jace::proxy::types::JInt getLength(jobject obj);
 jvalue getElement(jobject obj, int index);
 
+/**
+ * Returns the length of the array, through the given JNIEnv, which must belong to the current thread.
+ */
+jace::proxy::types::JInt getLength(JNIEnv* env, jobject obj);
+
+/**
+ * Returns the element at the given index of an array whose elements are of the given kind,
+ * through the given JNIEnv, which must belong to the current thread.
+ * An ObjectKind element is a local reference.
+ *
+ * @throws a matching C++ proxy, if the index is out of bounds.
+ */
+jvalue getElement(JNIEnv* env, JTypeKind kind, jobject obj, int index);
+
 END_NAMESPACE_2(jace, JArrayHelper)
 
 #endif
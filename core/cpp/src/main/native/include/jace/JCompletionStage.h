@@ -0,0 +1,150 @@
+#ifndef JACE_JCOMPLETION_STAGE_H
+#define JACE_JCOMPLETION_STAGE_H
+
+#include "jace/Namespace.h"
+#include "jace/JResult.h"
+#include "jace/proxy/JObject.h"
+
+#include <jni.h>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#  include <atomic>
+#  include <coroutine>
+#  define JACE_HAS_COROUTINES
+#endif
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * Receives the outcome of a java.util.concurrent.CompletionStage.
+ *
+ * @see whenComplete
+ */
+class JCompletionListener
+{
+public:
+	virtual ~JCompletionListener()
+	{}
+
+	/**
+	 * Called once the stage completes, on the java thread that completed it.
+	 *
+	 * Must not throw. Any reference it needs to keep must be turned into a global reference,
+	 * for example by wrapping it in a proxy or a JavaThrowable.
+	 *
+	 * @param result a local reference to the value of the stage, null if it completed exceptionally
+	 * @param error a local reference to the exception of the stage, or null. A CompletionException
+	 * wrapping the actual exception is unwrapped.
+	 */
+	virtual void onComplete(JNIEnv* env, jobject result, jthrowable error) = 0;
+};
+
+
+/**
+ * Registers a listener for the completion of a java.util.concurrent.CompletionStage,
+ * such as a CompletableFuture, through CompletionStage.whenComplete().
+ *
+ * No thread waits for the stage: the listener is a native callback, made through a
+ * NativeProxy implementing java.util.function.BiConsumer. If the stage has already
+ * completed, the listener is called before this function returns.
+ *
+ * @param listener must stay alive until it is called
+ * @throws JNIException if the stage is null, or the listener cannot be registered
+ */
+void whenComplete(const ::jace::proxy::JObject& stage, JCompletionListener* listener);
+
+
+#ifdef JACE_HAS_COROUTINES
+
+/**
+ * Suspends a C++20 coroutine until a java.util.concurrent.CompletionStage completes.
+ *
+ * The coroutine is resumed on the java thread that completes the stage, or continues
+ * right away if it has already completed.
+ *
+ * @see await
+ */
+template <class T> class JCompletionAwaiter: private JCompletionListener
+{
+public:
+	explicit JCompletionAwaiter(const ::jace::proxy::JObject& stage):
+		mStage(stage), mResult(static_cast<jobject>(0)), mState(0)
+	{}
+
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+
+	bool await_suspend(std::coroutine_handle<> handle)
+	{
+		mHandle = handle;
+		whenComplete(mStage, this);
+
+		// Whichever of onComplete() and await_suspend() comes second resumes the coroutine.
+		// If onComplete() already ran, the coroutine continues without being suspended.
+		return mState.exchange(1, std::memory_order_acq_rel) == 0;
+	}
+
+	/**
+	 * Returns the value of the stage.
+	 *
+	 * @throws a matching C++ proxy, if the stage completed exceptionally.
+	 */
+	T await_resume()
+	{
+		if (!mError.isNull())
+			mError.rethrow();
+		return T(static_cast<jobject>(mResult));
+	}
+
+	JCompletionAwaiter(const JCompletionAwaiter&) = delete;
+	JCompletionAwaiter& operator=(const JCompletionAwaiter&) = delete;
+
+private:
+	void onComplete(JNIEnv*, jobject result, jthrowable error) override
+	{
+		try
+		{
+			if (error)
+				mError = JavaThrowable(error);
+			else
+				mResult = ::jace::proxy::JObject(result);
+		}
+		catch (...)
+		{
+			// Could not keep a reference to the outcome, the coroutine observes a null result
+		}
+
+		if (mState.exchange(1, std::memory_order_acq_rel) == 1)
+			mHandle.resume();
+	}
+
+	::jace::proxy::JObject mStage;
+	::jace::proxy::JObject mResult;
+	JavaThrowable mError;
+	std::coroutine_handle<> mHandle;
+	std::atomic<int> mState;
+};
+
+
+/**
+ * Awaits a java.util.concurrent.CompletionStage from a C++20 coroutine.
+ *
+ * For example:
+ *
+ *   String body = co_await jace::await<String>(client.sendAsync(request, handler));
+ *
+ * @throws a matching C++ proxy, if the stage completed exceptionally.
+ */
+template <class T> JCompletionAwaiter<T> await(const ::jace::proxy::JObject& stage)
+{
+	return JCompletionAwaiter<T>(stage);
+}
+
+#endif // #ifdef JACE_HAS_COROUTINES
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JCOMPLETION_STAGE_H
@@ -4,6 +4,16 @@
 #include "jace/Namespace.h"
 #include "jace/JClass.h"
 
+#include <jni.h>
+
+#include <string>
+
+#include <boost/atomic.hpp>
+
+BEGIN_NAMESPACE_2(jace, proxy)
+class JValue;
+END_NAMESPACE_2(jace, proxy)
+
 BEGIN_NAMESPACE(jace)
 class JArguments;
 
@@ -11,6 +21,11 @@ class JArguments;
 /**
  * Represents a java constructor.
  *
+ * The jmethodID is resolved on first use and cached for the lifetime of the JConstructor.
+ * Resolution is thread-safe, so a single JConstructor may be shared by any number of
+ * threads. Generated proxy factories share one JConstructor per java constructor,
+ * created once through boost::call_once.
+ *
  * @author Toby Reyelts
  */
 class JConstructor
@@ -21,6 +36,17 @@ public:
 	 */
 	JConstructor(const ::jace::JClass& javaClass);
 
+	/**
+	 * Creates a new JConstructor for the given JClass, using the constructor
+	 * with the given JNI signature (see JMethodSignature).
+	 */
+	JConstructor(const ::jace::JClass& javaClass, const std::string& signature);
+
+	/**
+	 * Creates a copy of an existing JConstructor, including its cached jmethodID.
+	 */
+	JConstructor(const JConstructor& other);
+
 	/**
 	 * Invokes the constructor with the given JArguments.
 	 *
@@ -29,18 +55,47 @@ public:
 	 */
 	jobject invoke(const JArguments& arguments);
 
+	/**
+	 * Invokes the constructor with the given arguments.
+	 *
+	 * Unlike invoke(JArguments), the arguments are marshalled on the stack
+	 * without allocating.
+	 *
+	 * @return a new local reference to the object.
+	 * @throws JNIException if an error occurs while trying to invoke the constructor.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the constructor.
+	 */
+	jobject invoke();
+	jobject invoke(const ::jace::proxy::JValue& a0);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8);
+	jobject invoke(const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9);
+
 private:
 	/**
 	 * Prevent assignment.
 	 */
 	JConstructor& operator=(JConstructor&);
+
+	/**
+	 * Invokes the constructor with arguments that have already been converted to jvalues.
+	 */
+	jobject construct(const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count);
+
 	/**
 	 * Gets the method id matching the given arguments.
 	 */
-	jmethodID getMethodID(const ::jace::JClass& jClass, const JArguments& arguments);
+	jmethodID getMethodID(const ::jace::proxy::JValue* const* values, size_t count);
 
 	const ::jace::JClass& mClass;
-	jmethodID mMethodID;
+	const std::string mSignature;
+	boost::atomic<jmethodID> mMethodID;
 };
 
 END_NAMESPACE(jace)
@@ -4,6 +4,7 @@
 #include "Namespace.h"
 #include "jace/proxy/JObject.h"
 #include "jace/JClass.h"
+#include "jace/JTypeKind.h"
 
 #include "jni.h"
 #include <string>
@@ -17,6 +18,29 @@ public:
 
   jvalue getField(jace::proxy::JObject& object);
   jvalue getField(const jace::JClass& jClass);
+
+  /**
+   * Retrieves the value of the field through the Get<Type>Field function matching kind.
+   * An ObjectKind value is a local reference.
+   */
+  jvalue getField(jace::proxy::JObject& object, JTypeKind kind);
+
+  /**
+   * Retrieves the value of the static field through the GetStatic<Type>Field function matching kind.
+   * An ObjectKind value is a local reference.
+   */
+  jvalue getField(const jace::JClass& jClass, JTypeKind kind);
+
+  /**
+   * Retrieves the value of the field through the given JNIEnv, which must belong to the current thread.
+   */
+  jvalue getField(JNIEnv* env, jace::proxy::JObject& object, JTypeKind kind);
+
+  /**
+   * Retrieves the value of the static field through the given JNIEnv, which must belong to the current thread.
+   */
+  jvalue getField(JNIEnv* env, const jace::JClass& jClass, JTypeKind kind);
+
   jfieldID getFieldID(const jace::JClass& parentClass, bool isStatic);
   jfieldID getFieldID();
 
@@ -4,6 +4,7 @@
 #include "Namespace.h"
 #include "jace/proxy/JObject.h"
 #include "jace/JClass.h"
+#include "jace/JTypeKind.h"
 
 #include "jni.h"
 
@@ -12,6 +13,16 @@ BEGIN_NAMESPACE_2(jace, JFieldProxyHelper)
 jobject assign(const jace::proxy::JObject& field, jobject parent, jfieldID fieldID);
 jobject assign(const jace::proxy::JObject& field, jclass parentClass, jfieldID fieldID);
 
+/**
+ * Sets the value of a field through the Set<Type>Field function matching kind.
+ */
+void assign(JTypeKind kind, jvalue value, jobject parent, jfieldID fieldID);
+
+/**
+ * Sets the value of a static field through the SetStatic<Type>Field function matching kind.
+ */
+void assign(JTypeKind kind, jvalue value, jclass parentClass, jfieldID fieldID);
+
 END_NAMESPACE_2(jace, JFieldProxyHelper)
 
 #endif
@@ -0,0 +1,320 @@
+#ifndef JACE_JFUTURE_H
+#define JACE_JFUTURE_H
+
+#include "jace/Namespace.h"
+#include "jace/Jace.h"
+#include "jace/JNIException.h"
+#include "jace/JResult.h"
+#include "jace/JvmExecutor.h"
+#include "jace/proxy/JObject.h"
+#include "jace/proxy/types/JVoid.h"
+
+#include <jni.h>
+
+#include <exception>
+#include <string>
+
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/future.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * The result of a call made through jace::async(), which completes once a
+ * JvmExecutor worker has made the call.
+ *
+ * Copies of a JFuture share the same result.
+ */
+template <class T> class JFuture
+{
+public:
+	typedef boost::shared_future< JResult<T> > Future;
+
+	/**
+	 * Creates a JFuture for the given result.
+	 */
+	explicit JFuture(const Future& future): mFuture(future)
+	{}
+
+	/**
+	 * Returns true if the call is complete.
+	 */
+	bool isReady() const
+	{
+		return mFuture.is_ready();
+	}
+
+	/**
+	 * Waits until the call is complete.
+	 */
+	void wait() const
+	{
+		mFuture.wait();
+	}
+
+	/**
+	 * Waits until the call is complete, or until the given time has passed,
+	 * such as boost::posix_time::milliseconds(10).
+	 *
+	 * @return true if the call is complete
+	 */
+	template <class Duration> bool waitFor(const Duration& relativeTime) const
+	{
+		return mFuture.timed_wait(relativeTime);
+	}
+
+	/**
+	 * Waits until the call is complete, and returns the value it returned.
+	 *
+	 * @throws a matching C++ proxy, if the call threw a java exception.
+	 * It is translated on the calling thread.
+	 * @throws JNIException if an error occurred while making the call.
+	 */
+	T get() const
+	{
+		return mFuture.get().getValue();
+	}
+
+	/**
+	 * Waits until the call is complete, and returns its result, without throwing
+	 * a java exception thrown by the call.
+	 *
+	 * @throws JNIException if an error occurred while making the call.
+	 */
+	JResult<T> getResult() const
+	{
+		return mFuture.get();
+	}
+
+	/**
+	 * Returns the underlying future.
+	 */
+	const Future& getFuture() const
+	{
+		return mFuture;
+	}
+
+private:
+	Future mFuture;
+};
+
+
+/**
+ * Maps the return type of a call to the type of its JFuture. Calls returning
+ * void produce a JFuture<JVoid>.
+ *
+ * This class is internal to the JACE library.
+ */
+template <class R> struct JAsyncResult
+{
+	typedef R Type;
+
+	static Type invoke(const boost::function<R ()>& call)
+	{
+		return call();
+	}
+};
+
+template <> struct JAsyncResult<void>
+{
+	typedef ::jace::proxy::types::JVoid Type;
+
+	static Type invoke(const boost::function<void ()>& call)
+	{
+		call();
+		return Type();
+	}
+};
+
+
+/**
+ * A call queued on a JvmExecutor, which delivers its result to a JFuture.
+ *
+ * A java exception thrown by the call is delivered as a JavaThrowable, so that it can be
+ * translated into the matching C++ proxy on the thread that retrieves the result.
+ *
+ * This class is internal to the JACE library.
+ */
+template <class R> class JAsyncCall
+{
+public:
+	typedef typename JAsyncResult<R>::Type ResultType;
+	typedef boost::promise< JResult<ResultType> > Promise;
+
+	/**
+	 * Queues the call on the executor.
+	 *
+	 * @throws JNIException if the executor has been shut down
+	 */
+	static JFuture<ResultType> submit(JvmExecutor& executor, const boost::function<R ()>& call)
+	{
+		JAsyncCall task(call);
+		JFuture<ResultType> future(typename JFuture<ResultType>::Future(task.mPromise->get_future()));
+		executor.submit(task);
+		return future;
+	}
+
+	/**
+	 * Makes the call, on a worker.
+	 */
+	void operator()(JNIEnv*)
+	{
+		try
+		{
+			mPromise->set_value(JResult<ResultType>(JAsyncResult<R>::invoke(mCall)));
+		}
+		catch (::jace::proxy::JObject& throwable)
+		{
+			// Every C++ proxy exception is a JObject
+			jthrowable localThrowable = static_cast<jthrowable>(static_cast<jobject>(throwable));
+			mPromise->set_value(JResult<ResultType>(JavaThrowable(localThrowable)));
+		}
+		catch (JNIException& e)
+		{
+			mPromise->set_exception(boost::copy_exception(e));
+		}
+		catch (std::exception& e)
+		{
+			mPromise->set_exception(boost::copy_exception(JNIException(std::string("jace::async\n") + e.what())));
+		}
+		catch (...)
+		{
+			mPromise->set_exception(boost::copy_exception(JNIException("jace::async\nUnknown exception.")));
+		}
+	}
+
+private:
+	JAsyncCall(const boost::function<R ()>& call): mCall(call), mPromise(new Promise)
+	{}
+
+	boost::function<R ()> mCall;
+	boost::shared_ptr<Promise> mPromise;
+};
+
+
+/**
+ * Makes a call on a JvmExecutor worker, and returns a JFuture for its result.
+ *
+ * The call is a function object taking no arguments and returning R, such as:
+ *
+ *   JFuture<JInt> length = jace::async<JInt>(executor, boost::bind(&String::length, text));
+ *
+ * @throws JNIException if the executor has been shut down
+ */
+template <class R, class F> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor, const F& call)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(call));
+}
+
+/**
+ * Invokes a method of a proxy on a JvmExecutor worker, and returns a JFuture for its result.
+ *
+ * For example:
+ *
+ *   JFuture<JBoolean> found = jace::async(executor, map, &Map::containsKey, key);
+ *
+ * The proxy and the arguments are copied before returning, the method is invoked on the copies.
+ *
+ * @throws JNIException if the executor has been shut down
+ */
+template <class R, class P> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)())
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object)));
+}
+
+template <class R, class P, class A0, class T0> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)(A0), const T0& a0)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object, A0(a0))));
+}
+
+template <class R, class P, class A0, class A1, class T0, class T1> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)(A0, A1), const T0& a0, const T1& a1)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object, A0(a0), A1(a1))));
+}
+
+template <class R, class P, class A0, class A1, class A2, class T0, class T1, class T2> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)(A0, A1, A2), const T0& a0, const T1& a1, const T2& a2)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object, A0(a0), A1(a1), A2(a2))));
+}
+
+template <class R, class P, class A0, class A1, class A2, class A3, class T0, class T1, class T2, class T3> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)(A0, A1, A2, A3), const T0& a0, const T1& a1, const T2& a2, const T3& a3)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object, A0(a0), A1(a1), A2(a2), A3(a3))));
+}
+
+template <class R, class P, class A0, class A1, class A2, class A3, class A4, class T0, class T1, class T2, class T3, class T4> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)(A0, A1, A2, A3, A4), const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object, A0(a0), A1(a1), A2(a2), A3(a3), A4(a4))));
+}
+
+template <class R, class P, class A0, class A1, class A2, class A3, class A4, class A5, class T0, class T1, class T2, class T3, class T4, class T5> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	const P& object, R (P::*method)(A0, A1, A2, A3, A4, A5), const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4, const T5& a5)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(method, object, A0(a0), A1(a1), A2(a2), A3(a3), A4(a4), A5(a5))));
+}
+
+/**
+ * Invokes a static method of a proxy on a JvmExecutor worker, and returns a JFuture for its result.
+ *
+ * For example:
+ *
+ *   JFuture<JInt> value = jace::async(executor, &Integer::parseInt, String("42"));
+ *
+ * The arguments are copied before returning, the method is invoked on the copies.
+ *
+ * @throws JNIException if the executor has been shut down
+ */
+template <class R> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor, R (*function)())
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(function));
+}
+
+template <class R, class A0, class T0> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	R (*function)(A0), const T0& a0)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(function, A0(a0))));
+}
+
+template <class R, class A0, class A1, class T0, class T1> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	R (*function)(A0, A1), const T0& a0, const T1& a1)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(function, A0(a0), A1(a1))));
+}
+
+template <class R, class A0, class A1, class A2, class T0, class T1, class T2> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	R (*function)(A0, A1, A2), const T0& a0, const T1& a1, const T2& a2)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(function, A0(a0), A1(a1), A2(a2))));
+}
+
+template <class R, class A0, class A1, class A2, class A3, class T0, class T1, class T2, class T3> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	R (*function)(A0, A1, A2, A3), const T0& a0, const T1& a1, const T2& a2, const T3& a3)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(function, A0(a0), A1(a1), A2(a2), A3(a3))));
+}
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class T0, class T1, class T2, class T3, class T4> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	R (*function)(A0, A1, A2, A3, A4), const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(function, A0(a0), A1(a1), A2(a2), A3(a3), A4(a4))));
+}
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class A5, class T0, class T1, class T2, class T3, class T4, class T5> JFuture<typename JAsyncResult<R>::Type> async(JvmExecutor& executor,
+	R (*function)(A0, A1, A2, A3, A4, A5), const T0& a0, const T1& a1, const T2& a2, const T3& a3, const T4& a4, const T5& a5)
+{
+	return JAsyncCall<R>::submit(executor, boost::function<R ()>(boost::bind(function, A0(a0), A1(a1), A2(a2), A3(a3), A4(a4), A5(a5))));
+}
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JFUTURE_H
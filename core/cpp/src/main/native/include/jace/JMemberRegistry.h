@@ -0,0 +1,91 @@
+#ifndef JACE_JMEMBER_REGISTRY_H
+#define JACE_JMEMBER_REGISTRY_H
+
+#include "jace/Namespace.h"
+#include "jace/JClass.h"
+
+#include <jni.h>
+
+#include <string>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A process-wide cache of jmethodIDs and jfieldIDs.
+ *
+ * Members are keyed by their class, their name and their JNI signature, so every
+ * JMethod, JConstructor or JField referring to the same member shares a single
+ * lookup, no matter how many of them are created. Classes are told apart by
+ * identity, not only by name, so same-named classes from different class loaders
+ * get their own members.
+ *
+ * Lookups of members that have already been resolved do not take any locks.
+ * Only the first resolution of a member (a "miss") takes a mutex.
+ *
+ * The registry is cleared by resetJavaVm(). It must not be used while the
+ * virtual machine is being reset.
+ */
+class JMemberRegistry
+{
+public:
+	/**
+	 * Returns the jmethodID of the given method, looking it up in jClass if it
+	 * has not been resolved yet.
+	 *
+	 * @return 0 if the method does not exist, in which case a java exception is pending
+	 */
+	static jmethodID getMethodID(const JClass& jClass, const std::string& name, const std::string& signature,
+		bool isStatic = false);
+
+	/**
+	 * Returns the jmethodID of the given method, for classes that have no JClass.
+	 *
+	 * @param className the internal name of jClass, such as "java/lang/Object"
+	 * @return 0 if the method does not exist, in which case a java exception is pending
+	 */
+	static jmethodID getMethodID(jclass jClass, const std::string& className, const std::string& name,
+		const std::string& signature, bool isStatic = false);
+
+	/**
+	 * Returns the jfieldID of the given field, looking it up in jClass if it
+	 * has not been resolved yet.
+	 *
+	 * @return 0 if the field does not exist, in which case a java exception is pending
+	 */
+	static jfieldID getFieldID(const JClass& jClass, const std::string& name, const std::string& signature,
+		bool isStatic = false);
+
+	/**
+	 * Returns the number of lookups that were answered from the registry.
+	 */
+	static unsigned long hits();
+
+	/**
+	 * Returns the number of lookups that had to ask the virtual machine.
+	 */
+	static unsigned long misses();
+
+	/**
+	 * Returns the number of members in the registry.
+	 */
+	static size_t size();
+
+	/**
+	 * Forgets all members and resets the counters.
+	 *
+	 * Called by resetJavaVm(), since member ids are only valid for the virtual machine they came from.
+	 */
+	static void reset();
+
+private:
+	/**
+	 * Prevent instantiation.
+	 */
+	JMemberRegistry();
+};
+
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JMEMBER_REGISTRY_H
@@ -8,6 +8,11 @@
 #include "jace/JArguments.h"
 #include "jace/JNIException.h"
 #include "jace/JSignature.h"
+#include "jace/JResult.h"
+#include "jace/JMethodHelper.h"
+#include "jace/JTypeKind.h"
+#include "jace/Local.h"
+#include "jace/LocalFrame.h"
 #include "jace/proxy/types/JBoolean.h"
 #include "jace/proxy/types/JByte.h"
 #include "jace/proxy/types/JChar.h"
@@ -25,6 +30,9 @@
 #include <list>
 #include <iostream>
 
+#include <boost/static_assert.hpp>
+
+
 
 BEGIN_NAMESPACE(jace)
 
@@ -34,19 +42,237 @@ BEGIN_NAMESPACE(jace)
  */
 std::vector<jvalue> toVector(const JArguments& arguments);
 
+
+/**
+ * Calls a java method returning ResultType, through JMethodHelper.
+ *
+ * call() and callStatic() leave any java exception pending, the caller must check
+ * for it before converting the JNIResult to a ResultType with toResult().
+ *
+ * The JNI calls themselves are made by JMethodHelper according to the JTypeKind of
+ * ResultType, so this only converts the result. The primary template handles primitive
+ * types, which are constructed from the jvalue.
+ */
+template <class ResultType, int Kind = JTypeKindOf<ResultType>::value> struct JMethodCall
+{
+	typedef jvalue JNIResult;
+
+	static JNIResult call(JNIEnv* env, jobject object, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::call(env, static_cast<JTypeKind>(Kind), object, methodID, arguments);
+	}
+
+	static JNIResult callStatic(JNIEnv* env, jclass jClass, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::callStatic(env, static_cast<JTypeKind>(Kind), jClass, methodID, arguments);
+	}
+
+	static ResultType toResult(JNIEnv*, JNIResult result)
+	{
+		return ResultType(result);
+	}
+};
+
+/**
+ * Methods returning objects.
+ */
+template <class ResultType> struct JMethodCall<ResultType, ObjectKind>
+{
+	typedef jvalue JNIResult;
+
+	static JNIResult call(JNIEnv* env, jobject object, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::call(env, ObjectKind, object, methodID, arguments);
+	}
+
+	static JNIResult callStatic(JNIEnv* env, jclass jClass, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::callStatic(env, ObjectKind, jClass, methodID, arguments);
+	}
+
+	/**
+	 * Wraps the result in a proxy, and deletes the local reference.
+	 */
+	static ResultType toResult(JNIEnv* env, JNIResult result)
+	{
+		ResultType proxy(result.l);
+		if (result.l)
+			env->DeleteLocalRef(result.l);
+
+		return proxy;
+	}
+};
+
+/**
+ * Methods returning a Local, whose result keeps its local reference.
+ */
+template <class T> struct JMethodCall< ::jace::Local<T>, ObjectKind>
+{
+	typedef jvalue JNIResult;
+
+	static JNIResult call(JNIEnv* env, jobject object, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::call(env, ObjectKind, object, methodID, arguments);
+	}
+
+	static JNIResult callStatic(JNIEnv* env, jclass jClass, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::callStatic(env, ObjectKind, jClass, methodID, arguments);
+	}
+
+	/**
+	 * Borrows the local reference, which is left to the caller.
+	 */
+	static ::jace::Local<T> toResult(JNIEnv*, JNIResult result)
+	{
+		return ::jace::Local<T>(result.l);
+	}
+};
+
+/**
+ * Methods returning void.
+ */
+template <class ResultType> struct JMethodCall<ResultType, VoidKind>
+{
+	typedef jvalue JNIResult;
+
+	static JNIResult call(JNIEnv* env, jobject object, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::call(env, VoidKind, object, methodID, arguments);
+	}
+
+	static JNIResult callStatic(JNIEnv* env, jclass jClass, jmethodID methodID, jvalue* arguments)
+	{
+		return JMethodHelper::callStatic(env, VoidKind, jClass, methodID, arguments);
+	}
+
+	static ResultType toResult(JNIEnv*, JNIResult)
+	{
+		return ResultType();
+	}
+};
+
+
+/**
+ * The state shared by the calls of a JMethod::invokeAll() batch.
+ *
+ * A batch attaches once, and makes all of its calls inside a single local reference frame.
+ */
+class JMethodBatch
+{
+public:
+	/**
+	 * How java exceptions thrown by the calls of a batch are reported.
+	 */
+	enum ExceptionMode
+	{
+		/**
+		 * The batch stops at the first call that throws a java exception,
+		 * and rethrows it as a C++ proxy exception.
+		 */
+		StopOnException,
+
+		/**
+		 * The batch makes every call. The first java exception is remembered,
+		 * and rethrown as a C++ proxy exception once the batch is complete.
+		 * Calls that threw produce a null (or zero) result.
+		 */
+		ThrowAfterBatch
+	};
+
+	/**
+	 * Attaches the current thread, and pushes the local frame of the batch.
+	 *
+	 * @throws JNIException if the local frame cannot be allocated.
+	 */
+	explicit JMethodBatch(ExceptionMode mode);
+
+	/**
+	 * Pops the local frame of the batch.
+	 */
+	~JMethodBatch();
+
+	/**
+	 * Returns the JNIEnv of the current thread.
+	 */
+	JNIEnv* getEnv() const;
+
+	/**
+	 * Checks for a java exception after a call of the batch.
+	 *
+	 * @throws a matching C++ proxy, in StopOnException mode.
+	 */
+	void check();
+
+	/**
+	 * Rethrows the first java exception of the batch, if any.
+	 *
+	 * @throws a matching C++ proxy, in ThrowAfterBatch mode.
+	 */
+	void finish();
+
+private:
+	/**
+	 * Prevent copying.
+	 */
+	JMethodBatch(const JMethodBatch&);
+	JMethodBatch& operator=(const JMethodBatch&);
+
+	JNIEnv* mEnv;
+	LocalFrame mFrame;
+	const ExceptionMode mMode;
+	jthrowable mFirstException;
+};
+
+
 /**
  * Represents a java method.
  *
+ * The jmethodID is resolved on first use and cached for the lifetime of the JMethod.
+ * Resolution is thread-safe, so a single JMethod may be shared by any number of
+ * threads. Generated proxies share one JMethod per java method for this reason,
+ * created once through boost::call_once.
+ *
  * @author Toby Reyelts
  */
 template <class ResultType> class JMethod
 {
 public:
+	/**
+	 * Creates a new JMethod representing the method with the
+	 * given name. The method is looked up in the class of the
+	 * first object (or class) it is invoked on.
+	 */
+	JMethod(const std::string& name): mHelper(name, 0, std::string())
+	{}
+
 	/**
 	 * Creates a new JMethod representing the method with the
 	 * given name, belonging to the given class.
+	 *
+	 * The method is always looked up in declaringClass, which makes
+	 * the cached jmethodID valid for every receiver, no matter which
+	 * subclass it was first invoked on.
+	 */
+	JMethod(const JClass& declaringClass, const std::string& name):
+		mHelper(name, &declaringClass, std::string())
+	{}
+
+	/**
+	 * Creates a new JMethod representing the method with the
+	 * given name and JNI signature, belonging to the given class.
+	 *
+	 * The signature is used as-is (see JMethodSignature), so looking
+	 * up the method does not depend on the runtime types of the arguments.
+	 */
+	JMethod(const JClass& declaringClass, const std::string& name, const std::string& signature):
+		mHelper(name, &declaringClass, signature)
+	{}
+
+	/**
+	 * Creates a copy of an existing JMethod, including its cached jmethodID.
 	 */
-	JMethod(const std::string& name): mName(name), mMethodID(0)
+	JMethod(const JMethod& other): mHelper(other.mHelper)
 	{}
 
 	/**
@@ -58,571 +284,763 @@ public:
 	 */
 	ResultType invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
 	{
-#ifdef JACE_CHECK_NULLS
-		if (object.isNull())
-			throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-#endif
+		JArgumentValues values(arguments);
+		return invokeObject(attach(), object, arguments.values(), values.get(), arguments.size());
+	}
 
-		// Get the methodID for the method matching the given arguments.
-		jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
+	/**
+	 * Invokes the method with the given arguments.
+	 * The method is invoked statically, on the supplied class.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	ResultType invoke(const JClass& jClass, const JArguments& arguments)
+	{
+		JArgumentValues values(arguments);
+		return invokeStatic(attach(), jClass, arguments.values(), values.get(), arguments.size());
+	}
 
-		// Call the method.
-		JNIEnv* env = attach();
-		jobject resultRef;
+	/**
+	 * Invokes the method with the given arguments.
+	 * The method is invoked on the supplied object.
+	 *
+	 * Unlike invoke(object, JArguments), the arguments are marshalled on the stack
+	 * without allocating.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	ResultType invoke(const ::jace::proxy::JObject& object)
+	{
+		jvalue arguments[1];
+		return invokeObject(attach(), object, 0, arguments, 0);
+	}
 
-		if (arguments.asList().size() > 0)
-			resultRef = env->CallObjectMethodA(object, methodID, &toVector(arguments)[0]);
-		else
-			resultRef = env->CallObjectMethod(object, methodID);
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0 };
+		jvalue arguments[] = { a0 };
+		return invokeObject(attach(), object, values, arguments, 1);
+	}
 
-		// Catch any java exception that occured during the method call, and throw it as a C++ exception.
-		catchAndThrow();
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1 };
+		jvalue arguments[] = { a0, a1 };
+		return invokeObject(attach(), object, values, arguments, 2);
+	}
 
-		ResultType result(resultRef);
-		env->DeleteLocalRef(resultRef), resultRef = 0;
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2 };
+		jvalue arguments[] = { a0, a1, a2 };
+		return invokeObject(attach(), object, values, arguments, 3);
+	}
+
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3 };
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invokeObject(attach(), object, values, arguments, 4);
+	}
+
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invokeObject(attach(), object, values, arguments, 5);
+	}
+
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invokeObject(attach(), object, values, arguments, 6);
+	}
+
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invokeObject(attach(), object, values, arguments, 7);
+	}
+
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invokeObject(attach(), object, values, arguments, 8);
+	}
 
-		return result;
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invokeObject(attach(), object, values, arguments, 9);
 	}
 
+	ResultType invoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invokeObject(attach(), object, values, arguments, 10);
+	}
 
 	/**
 	 * Invokes the method with the given arguments.
 	 * The method is invoked statically, on the supplied class.
 	 *
+	 * Unlike invoke(jClass, JArguments), the arguments are marshalled on the stack
+	 * without allocating.
+	 *
 	 * @throws JNIException if an error occurs while trying to invoke the method.
 	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
 	 */
-	ResultType invoke(const JClass& jClass, const JArguments& arguments)
+	ResultType invoke(const JClass& jClass)
 	{
-		// Get the methodID for the method matching the given arguments.
-		jmethodID methodID = getMethodID(jClass, arguments, true);
+		jvalue arguments[1];
+		return invokeStatic(attach(), jClass, 0, arguments, 0);
+	}
 
-		// Call the method.
-		JNIEnv* env = attach();
-		jobject resultRef;
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0 };
+		jvalue arguments[] = { a0 };
+		return invokeStatic(attach(), jClass, values, arguments, 1);
+	}
 
-		if (arguments.asList().size() > 0)
-			resultRef = env->CallStaticObjectMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-		else
-			resultRef = env->CallStaticObjectMethod(jClass.getClass(), methodID);
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1 };
+		jvalue arguments[] = { a0, a1 };
+		return invokeStatic(attach(), jClass, values, arguments, 2);
+	}
+
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2 };
+		jvalue arguments[] = { a0, a1, a2 };
+		return invokeStatic(attach(), jClass, values, arguments, 3);
+	}
 
-		// Catch any java exception that occured during the method call, and throw it as a C++ exception.
-		catchAndThrow();
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3 };
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invokeStatic(attach(), jClass, values, arguments, 4);
+	}
 
-		ResultType result(resultRef);
-		env->DeleteLocalRef(resultRef), resultRef = 0;
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invokeStatic(attach(), jClass, values, arguments, 5);
+	}
 
-		return result;
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invokeStatic(attach(), jClass, values, arguments, 6);
+	}
+
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invokeStatic(attach(), jClass, values, arguments, 7);
+	}
+
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invokeStatic(attach(), jClass, values, arguments, 8);
+	}
+
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invokeStatic(attach(), jClass, values, arguments, 9);
+	}
+
+	ResultType invoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invokeStatic(attach(), jClass, values, arguments, 10);
 	}
 
-protected:
 	/**
-	 * Returns the jmethodID matching the signature for the given arguments.
+	 * Invokes the method with the given arguments, on the supplied object,
+	 * through the JNIEnv of the current thread.
+	 *
+	 * Callers that already hold the JNIEnv, such as native methods and code running
+	 * in a JMethodBatch, can use these overloads to skip attach().
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
 	 */
-	jmethodID getMethodID(const JClass& jClass, const JArguments& arguments, bool isStatic = false)
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const JArguments& arguments)
 	{
-		// We cache the jmethodID locally, so if we've already found it, we don't need to go looking for it again.
-		if (mMethodID)
-			return mMethodID;
+		JArgumentValues values(arguments);
+		return invokeObject(env, object, arguments.values(), values.get(), arguments.size());
+	}
 
-		// If we don't already have the jmethodID, we need to determine the signature of this method.
-		JSignature signature(ResultType::staticGetJavaJniClass());
-		typedef std::list<const ::jace::proxy::JValue*> ValueList;
-		ValueList args = arguments.asList();
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object)
+	{
+		jvalue arguments[1];
+		return invokeObject(env, object, 0, arguments, 0);
+	}
 
-		ValueList::iterator i = args.begin();
-		ValueList::iterator end = args.end();
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0 };
+		jvalue arguments[] = { a0 };
+		return invokeObject(env, object, values, arguments, 1);
+	}
 
-		for (; i != end; ++i)
-		{
-			const ::jace::proxy::JValue* value = *i;
-			signature << value->getJavaJniClass();
-		}
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1 };
+		jvalue arguments[] = { a0, a1 };
+		return invokeObject(env, object, values, arguments, 2);
+	}
 
-		std::string methodSignature = signature.toString();
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2 };
+		jvalue arguments[] = { a0, a1, a2 };
+		return invokeObject(env, object, values, arguments, 3);
+	}
 
-		// Now that we have the signature for the method, we could look in a global cache for the
-		// jmethodID corresponding to this method, but for now, we'll always find it.
-		JNIEnv* env = attach();
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3 };
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invokeObject(env, object, values, arguments, 4);
+	}
 
-		if (isStatic)
-			mMethodID = env->GetStaticMethodID(jClass.getClass(), mName.c_str(), methodSignature.c_str());
-		else
-			mMethodID = env->GetMethodID(jClass.getClass(), mName.c_str(), methodSignature.c_str());
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invokeObject(env, object, values, arguments, 5);
+	}
 
-		if (mMethodID == 0)
-		{
-            THROW_JNI_EXCEPTION(std::string("JMethod::getMethodID\n") +
-				                            "Unable to find method <" + mName + 
-                                            "> with signature <" + methodSignature + ">");
-		}
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invokeObject(env, object, values, arguments, 6);
+	}
 
-		//  cout << "JMethod::getMethodID() - Found the method:" << endl;
-		//  cout << "  <" << mName << "> with signature <" << methodSignature << "> for " << jClass.getInternalName() << endl;
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invokeObject(env, object, values, arguments, 7);
+	}
 
-		return mMethodID;
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invokeObject(env, object, values, arguments, 8);
 	}
 
-private:
-	std::string mName;
-	jmethodID mMethodID;
-};
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invokeObject(env, object, values, arguments, 9);
+	}
 
-template <> inline
-::jace::proxy::types::JBoolean JMethod< ::jace::proxy::types::JBoolean >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	ResultType invoke(JNIEnv* env, const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invokeObject(env, object, values, arguments, 10);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jboolean result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallStaticBooleanMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticBooleanMethod(jClass.getClass(), methodID);
+	/**
+	 * Invokes the method with the given arguments, statically on the supplied class,
+	 * through the JNIEnv of the current thread.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const JArguments& arguments)
+	{
+		JArgumentValues values(arguments);
+		return invokeStatic(env, jClass, arguments.values(), values.get(), arguments.size());
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	ResultType invoke(JNIEnv* env, const JClass& jClass)
+	{
+		jvalue arguments[1];
+		return invokeStatic(env, jClass, 0, arguments, 0);
+	}
 
-  return ::jace::proxy::types::JBoolean(result);
-}
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0 };
+		jvalue arguments[] = { a0 };
+		return invokeStatic(env, jClass, values, arguments, 1);
+	}
 
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1 };
+		jvalue arguments[] = { a0, a1 };
+		return invokeStatic(env, jClass, values, arguments, 2);
+	}
 
-template <> inline
-::jace::proxy::types::JBoolean JMethod< ::jace::proxy::types::JBoolean >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jboolean result;
-  
-  if (arguments.asList().size() > 0)
-	result = env->CallBooleanMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallBooleanMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JBoolean(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JByte JMethod< ::jace::proxy::types::JByte >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2 };
+		jvalue arguments[] = { a0, a1, a2 };
+		return invokeStatic(env, jClass, values, arguments, 3);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jbyte result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallStaticByteMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticByteMethod(jClass.getClass(), methodID);
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3 };
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invokeStatic(env, jClass, values, arguments, 4);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invokeStatic(env, jClass, values, arguments, 5);
+	}
 
-  return ::jace::proxy::types::JByte(result);
-}
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invokeStatic(env, jClass, values, arguments, 6);
+	}
 
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invokeStatic(env, jClass, values, arguments, 7);
+	}
 
-template <> inline
-::jace::proxy::types::JByte JMethod< ::jace::proxy::types::JByte >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jbyte result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallByteMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallByteMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JByte(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JChar JMethod< ::jace::proxy::types::JChar >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invokeStatic(env, jClass, values, arguments, 8);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jchar result;
-  
-  if (arguments.asList().size() > 0)
-	result = env->CallStaticCharMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticCharMethod(jClass.getClass(), methodID);
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invokeStatic(env, jClass, values, arguments, 9);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	ResultType invoke(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invokeStatic(env, jClass, values, arguments, 10);
+	}
 
-  return ::jace::proxy::types::JChar(result);
-}
+	/**
+	 * Invokes the method with the given arguments.
+	 * The method is invoked on the supplied object.
+	 *
+	 * Unlike invoke(), a java exception thrown by the method is returned in the JResult,
+	 * instead of being thrown as a C++ proxy exception.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 */
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
+	{
+		JArgumentValues values(arguments);
+		return tryInvokeObject(object, arguments.values(), values.get(), arguments.size());
+	}
 
+	/**
+	 * Invokes the method with the given arguments.
+	 * The method is invoked statically, on the supplied class.
+	 *
+	 * Unlike invoke(), a java exception thrown by the method is returned in the JResult,
+	 * instead of being thrown as a C++ proxy exception.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 */
+	JResult<ResultType> tryInvoke(const JClass& jClass, const JArguments& arguments)
+	{
+		JArgumentValues values(arguments);
+		return tryInvokeStatic(jClass, arguments.values(), values.get(), arguments.size());
+	}
 
-template <> inline
-::jace::proxy::types::JChar JMethod< ::jace::proxy::types::JChar >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  /* Get the methodID for the method matching the given arguments.
-   */
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jchar result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallCharMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallCharMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JChar(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JDouble JMethod< ::jace::proxy::types::JDouble >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	/**
+	 * Invokes the method with the given arguments, marshalled on the stack.
+	 * The method is invoked on the supplied object.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 */
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object)
+	{
+		jvalue arguments[1];
+		return tryInvokeObject(object, 0, arguments, 0);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jdouble result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallStaticDoubleMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticDoubleMethod(jClass.getClass(), methodID);
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0 };
+		jvalue arguments[] = { a0 };
+		return tryInvokeObject(object, values, arguments, 1);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1 };
+		jvalue arguments[] = { a0, a1 };
+		return tryInvokeObject(object, values, arguments, 2);
+	}
 
-  return ::jace::proxy::types::JDouble(result);
-}
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2 };
+		jvalue arguments[] = { a0, a1, a2 };
+		return tryInvokeObject(object, values, arguments, 3);
+	}
 
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3 };
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return tryInvokeObject(object, values, arguments, 4);
+	}
 
-template <> inline
-::jace::proxy::types::JDouble JMethod< ::jace::proxy::types::JDouble >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jdouble result;
-  
-  if (arguments.asList().size() > 0)
-	result = env->CallDoubleMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallDoubleMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JDouble(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JFloat JMethod< ::jace::proxy::types::JFloat >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return tryInvokeObject(object, values, arguments, 5);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jfloat result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallStaticFloatMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticFloatMethod(jClass.getClass(), methodID);
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return tryInvokeObject(object, values, arguments, 6);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return tryInvokeObject(object, values, arguments, 7);
+	}
 
-  return ::jace::proxy::types::JFloat(result);
-}
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return tryInvokeObject(object, values, arguments, 8);
+	}
 
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return tryInvokeObject(object, values, arguments, 9);
+	}
 
-template <> inline
-::jace::proxy::types::JFloat JMethod< ::jace::proxy::types::JFloat >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jfloat result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallFloatMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallFloatMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JFloat(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JInt JMethod< ::jace::proxy::types::JInt >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	JResult<ResultType> tryInvoke(const ::jace::proxy::JObject& object, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return tryInvokeObject(object, values, arguments, 10);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jint result;
-  
-  if (arguments.asList().size() > 0)
-	result = env->CallStaticIntMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticIntMethod(jClass.getClass(), methodID);
+	/**
+	 * Invokes the method with the given arguments, marshalled on the stack.
+	 * The method is invoked statically, on the supplied class.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 */
+	JResult<ResultType> tryInvoke(const JClass& jClass)
+	{
+		jvalue arguments[1];
+		return tryInvokeStatic(jClass, 0, arguments, 0);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0 };
+		jvalue arguments[] = { a0 };
+		return tryInvokeStatic(jClass, values, arguments, 1);
+	}
 
-  return ::jace::proxy::types::JInt(result);
-}
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1 };
+		jvalue arguments[] = { a0, a1 };
+		return tryInvokeStatic(jClass, values, arguments, 2);
+	}
 
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2 };
+		jvalue arguments[] = { a0, a1, a2 };
+		return tryInvokeStatic(jClass, values, arguments, 3);
+	}
 
-template <> inline
-::jace::proxy::types::JInt JMethod< ::jace::proxy::types::JInt >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jint result;
-  
-  if (arguments.asList().size() > 0)
-	result = env->CallIntMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-	result = env->CallIntMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JInt(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JLong JMethod< ::jace::proxy::types::JLong >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3 };
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return tryInvokeStatic(jClass, values, arguments, 4);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jlong result;
-  
-  if (arguments.asList().size() > 0)
-	result = env->CallStaticLongMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-	result = env->CallStaticLongMethod(jClass.getClass(), methodID);
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return tryInvokeStatic(jClass, values, arguments, 5);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return tryInvokeStatic(jClass, values, arguments, 6);
+	}
 
-  return ::jace::proxy::types::JLong(result);
-}
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return tryInvokeStatic(jClass, values, arguments, 7);
+	}
 
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return tryInvokeStatic(jClass, values, arguments, 8);
+	}
 
-template <> inline
-::jace::proxy::types::JLong JMethod< ::jace::proxy::types::JLong >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jlong result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallLongMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallLongMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JLong(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JShort JMethod< ::jace::proxy::types::JShort >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return tryInvokeStatic(jClass, values, arguments, 9);
+	}
 
-  // Call the method.
-  JNIEnv* env = attach();
-  jshort result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallStaticShortMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallStaticShortMethod(jClass.getClass(), methodID);
+	JResult<ResultType> tryInvoke(const JClass& jClass, const ::jace::proxy::JValue& a0, const ::jace::proxy::JValue& a1, const ::jace::proxy::JValue& a2, const ::jace::proxy::JValue& a3, const ::jace::proxy::JValue& a4, const ::jace::proxy::JValue& a5, const ::jace::proxy::JValue& a6, const ::jace::proxy::JValue& a7, const ::jace::proxy::JValue& a8, const ::jace::proxy::JValue& a9)
+	{
+		const ::jace::proxy::JValue* values[] = { &a0, &a1, &a2, &a3, &a4, &a5, &a6, &a7, &a8, &a9 };
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return tryInvokeStatic(jClass, values, arguments, 10);
+	}
 
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
+	/**
+	 * Invokes the method on every object in the range [first, last), with the same arguments.
+	 *
+	 * The calls share one attach, one method lookup and one local frame. If results is not null,
+	 * the result of each call is appended to it.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method, as chosen by mode.
+	 */
+	template <class ReceiverIterator>
+	void invokeAll(ReceiverIterator first, ReceiverIterator last, const JArguments& arguments,
+		std::vector<ResultType>* results = 0, JMethodBatch::ExceptionMode mode = JMethodBatch::StopOnException)
+	{
+		JArgumentValues values(arguments);
+		JMethodBatch batch(mode);
+		JNIEnv* env = batch.getEnv();
 
-  return ::jace::proxy::types::JShort(result);
-}
+		for (; first != last; ++first)
+		{
+			const ::jace::proxy::JObject& object = *first;
 
+#ifdef JACE_CHECK_NULLS
+			if (object.isNull())
+				throw JNIException("[JMethod.invokeAll] Can not invoke an instance method on a null object.");
+#endif
 
-template <> inline
-::jace::proxy::types::JShort JMethod< ::jace::proxy::types::JShort >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  jshort result;
-  
-  if (arguments.asList().size() > 0)
-    result = env->CallShortMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-    result = env->CallShortMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JShort(result);
-}
-
-
-template <> inline
-::jace::proxy::types::JVoid JMethod< ::jace::proxy::types::JVoid >::invoke(const JClass& jClass, const JArguments& arguments)
-{
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(jClass, arguments, true);
-
-  // Call the method.
-  JNIEnv* env = attach();
-  
-  if (arguments.asList().size() > 0)
-    env->CallStaticVoidMethodA(jClass.getClass(), methodID, &toVector(arguments)[0]);
-  else
-    env->CallStaticVoidMethod(jClass.getClass(), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception. 
-  catchAndThrow();
-
-  return ::jace::proxy::types::JVoid();
-}
-
-template <> inline
-::jace::proxy::types::JVoid JMethod< ::jace::proxy::types::JVoid >::invoke(const ::jace::proxy::JObject& object, const JArguments& arguments)
-{
-  #ifdef JACE_CHECK_NULLS
-    if (object.isNull())
-      throw JNIException("[JMethod.invoke] Can not invoke an instance method on a null object.");
-  #endif
-
-  // Get the methodID for the method matching the given arguments.
-  jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments);
-
-  // Call the method.
-  JNIEnv* env = attach();
-
-  if (arguments.asList().size() > 0)
-	env->CallVoidMethodA(static_cast<jobject>(object), methodID, &toVector(arguments)[0]);
-  else
-	env->CallVoidMethod(static_cast<jobject>(object), methodID);
-
-  // Catch any java exception that occured during the method call,
-  // and throw it as a C++ exception.
-  catchAndThrow();
-  
-  return ::jace::proxy::types::JVoid();
-}
+			jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments.values(), arguments.size());
+			typename JMethodCall<ResultType>::JNIResult result =
+				JMethodCall<ResultType>::call(env, static_cast<jobject>(object), methodID, values.get());
+			batch.check();
+			collect(env, result, results);
+		}
+		batch.finish();
+	}
+
+	/**
+	 * Invokes the method on the supplied object, once for every JArguments in the range [first, last).
+	 *
+	 * The calls share one attach, one method lookup and one local frame. If results is not null,
+	 * the result of each call is appended to it.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method, as chosen by mode.
+	 */
+	template <class ArgumentsIterator>
+	void invokeAll(const ::jace::proxy::JObject& object, ArgumentsIterator first, ArgumentsIterator last,
+		std::vector<ResultType>* results = 0, JMethodBatch::ExceptionMode mode = JMethodBatch::StopOnException)
+	{
+#ifdef JACE_CHECK_NULLS
+		if (object.isNull())
+			throw JNIException("[JMethod.invokeAll] Can not invoke an instance method on a null object.");
+#endif
+
+		JMethodBatch batch(mode);
+		JNIEnv* env = batch.getEnv();
+
+		for (; first != last; ++first)
+		{
+			const JArguments& arguments = *first;
+			JArgumentValues values(arguments);
+
+			jmethodID methodID = getMethodID(object.getJavaJniClass(), arguments.values(), arguments.size());
+			typename JMethodCall<ResultType>::JNIResult result =
+				JMethodCall<ResultType>::call(env, static_cast<jobject>(object), methodID, values.get());
+			batch.check();
+			collect(env, result, results);
+		}
+		batch.finish();
+	}
+
+	/**
+	 * Invokes the method statically on the supplied class, once for every JArguments in the range [first, last).
+	 *
+	 * The calls share one attach, one method lookup and one local frame. If results is not null,
+	 * the result of each call is appended to it.
+	 *
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method, as chosen by mode.
+	 */
+	template <class ArgumentsIterator>
+	void invokeAll(const JClass& jClass, ArgumentsIterator first, ArgumentsIterator last,
+		std::vector<ResultType>* results = 0, JMethodBatch::ExceptionMode mode = JMethodBatch::StopOnException)
+	{
+		JMethodBatch batch(mode);
+		JNIEnv* env = batch.getEnv();
+
+		for (; first != last; ++first)
+		{
+			const JArguments& arguments = *first;
+			JArgumentValues values(arguments);
+
+			jmethodID methodID = getMethodID(jClass, arguments.values(), arguments.size(), true);
+			typename JMethodCall<ResultType>::JNIResult result =
+				JMethodCall<ResultType>::callStatic(env, jClass.getClass(), methodID, values.get());
+			batch.check();
+			collect(env, result, results);
+		}
+		batch.finish();
+	}
+
+protected:
+	/**
+	 * Returns the jmethodID matching the signature for the given arguments.
+	 */
+	jmethodID getMethodID(const JClass& jClass, const JArguments& arguments, bool isStatic = false)
+	{
+		return getMethodID(jClass, arguments.values(), arguments.size(), isStatic);
+	}
+
+	/**
+	 * Returns the jmethodID matching the signature for the given arguments.
+	 */
+	jmethodID getMethodID(const JClass& jClass, const ::jace::proxy::JValue* const* values, size_t count,
+		bool isStatic = false)
+	{
+		return mHelper.getMethodID(jClass, &ResultType::staticGetJavaJniClass, values, count, isStatic);
+	}
+
+private:
+	enum { Kind = JTypeKindOf<ResultType>::value };
+
+	/**
+	 * Invokes the method on the supplied object, with arguments that have already been converted to jvalues.
+	 */
+	ResultType invokeObject(JNIEnv* env, const ::jace::proxy::JObject& object,
+		const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count)
+	{
+		jvalue result = mHelper.invoke(env, static_cast<JTypeKind>(Kind), &ResultType::staticGetJavaJniClass, object,
+			values, arguments, count);
+		return JMethodCall<ResultType>::toResult(env, result);
+	}
+
+	/**
+	 * Invokes the method statically on the supplied class, with arguments that have already been converted to jvalues.
+	 */
+	ResultType invokeStatic(JNIEnv* env, const JClass& jClass, const ::jace::proxy::JValue* const* values,
+		jvalue* arguments, size_t count)
+	{
+		jvalue result = mHelper.invokeStatic(env, static_cast<JTypeKind>(Kind), &ResultType::staticGetJavaJniClass,
+			jClass, values, arguments, count);
+		return JMethodCall<ResultType>::toResult(env, result);
+	}
+
+	/**
+	 * Invokes the method on the supplied object, returning any java exception instead of throwing it.
+	 */
+	JResult<ResultType> tryInvokeObject(const ::jace::proxy::JObject& object,
+		const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count)
+	{
+		JNIEnv* env = attach();
+		JavaThrowable error;
+		jvalue result = mHelper.tryInvoke(env, static_cast<JTypeKind>(Kind), &ResultType::staticGetJavaJniClass,
+			object, values, arguments, count, error);
+		if (!error.isNull())
+			return JResult<ResultType>(error);
+		return JResult<ResultType>(JMethodCall<ResultType>::toResult(env, result));
+	}
+
+	/**
+	 * Invokes the method statically on the supplied class, returning any java exception instead of throwing it.
+	 */
+	JResult<ResultType> tryInvokeStatic(const JClass& jClass, const ::jace::proxy::JValue* const* values,
+		jvalue* arguments, size_t count)
+	{
+		JNIEnv* env = attach();
+		JavaThrowable error;
+		jvalue result = mHelper.tryInvokeStatic(env, static_cast<JTypeKind>(Kind),
+			&ResultType::staticGetJavaJniClass, jClass, values, arguments, count, error);
+		if (!error.isNull())
+			return JResult<ResultType>(error);
+		return JResult<ResultType>(JMethodCall<ResultType>::toResult(env, result));
+	}
+
+	/**
+	 * Appends the result of a call in a batch to results, or discards it if results is null.
+	 */
+	static void collect(JNIEnv* env, jvalue result, std::vector<ResultType>* results)
+	{
+		// The local references of a batch are released when it completes
+		BOOST_STATIC_ASSERT_MSG(!IsLocal<ResultType>::value, "invokeAll() can not return Locals");
+		if (results)
+			results->push_back(JMethodCall<ResultType>::toResult(env, result));
+		else
+			JMethodHelper::release(env, static_cast<JTypeKind>(Kind), result);
+	}
+
+	/**
+	 * Prevent assignment.
+	 */
+	JMethod& operator=(const JMethod&);
+
+	JMethodHelper mHelper;
+};
 
 END_NAMESPACE(jace)
 
@@ -0,0 +1,835 @@
+#ifndef JACE_JMETHOD_HANDLE_H
+#define JACE_JMETHOD_HANDLE_H
+
+#include "jace/Namespace.h"
+#include "jace/Jace.h"
+#include "jace/JClass.h"
+#include "jace/JMethod.h"
+#include "jace/JSignature.h"
+#include "jace/proxy/JObject.h"
+#include "jace/proxy/types/JVoid.h"
+
+#include <jni.h>
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * Splits a function type, such as JInt(String, JLong), into its result and argument types.
+ *
+ * Unused arguments are JNoArgument.
+ */
+template <class Signature> struct JFunctionTraits;
+
+template <class R> struct JFunctionTraits<R()>
+{
+	enum { arity = 0 };
+	typedef R Result;
+	typedef JNoArgument Argument0;
+	typedef JNoArgument Argument1;
+	typedef JNoArgument Argument2;
+	typedef JNoArgument Argument3;
+	typedef JNoArgument Argument4;
+	typedef JNoArgument Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0> struct JFunctionTraits<R(A0)>
+{
+	enum { arity = 1 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef JNoArgument Argument1;
+	typedef JNoArgument Argument2;
+	typedef JNoArgument Argument3;
+	typedef JNoArgument Argument4;
+	typedef JNoArgument Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1> struct JFunctionTraits<R(A0, A1)>
+{
+	enum { arity = 2 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef JNoArgument Argument2;
+	typedef JNoArgument Argument3;
+	typedef JNoArgument Argument4;
+	typedef JNoArgument Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2> struct JFunctionTraits<R(A0, A1, A2)>
+{
+	enum { arity = 3 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef JNoArgument Argument3;
+	typedef JNoArgument Argument4;
+	typedef JNoArgument Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3> struct JFunctionTraits<R(A0, A1, A2, A3)>
+{
+	enum { arity = 4 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef JNoArgument Argument4;
+	typedef JNoArgument Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3, class A4> struct JFunctionTraits<R(A0, A1, A2, A3, A4)>
+{
+	enum { arity = 5 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef A4 Argument4;
+	typedef JNoArgument Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class A5> struct JFunctionTraits<R(A0, A1, A2, A3, A4, A5)>
+{
+	enum { arity = 6 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef A4 Argument4;
+	typedef A5 Argument5;
+	typedef JNoArgument Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class A5, class A6> struct JFunctionTraits<R(A0, A1, A2, A3, A4, A5, A6)>
+{
+	enum { arity = 7 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef A4 Argument4;
+	typedef A5 Argument5;
+	typedef A6 Argument6;
+	typedef JNoArgument Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class A5, class A6, class A7> struct JFunctionTraits<R(A0, A1, A2, A3, A4, A5, A6, A7)>
+{
+	enum { arity = 8 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef A4 Argument4;
+	typedef A5 Argument5;
+	typedef A6 Argument6;
+	typedef A7 Argument7;
+	typedef JNoArgument Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8> struct JFunctionTraits<R(A0, A1, A2, A3, A4, A5, A6, A7, A8)>
+{
+	enum { arity = 9 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef A4 Argument4;
+	typedef A5 Argument5;
+	typedef A6 Argument6;
+	typedef A7 Argument7;
+	typedef A8 Argument8;
+	typedef JNoArgument Argument9;
+};
+
+template <class R, class A0, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9> struct JFunctionTraits<R(A0, A1, A2, A3, A4, A5, A6, A7, A8, A9)>
+{
+	enum { arity = 10 };
+	typedef R Result;
+	typedef A0 Argument0;
+	typedef A1 Argument1;
+	typedef A2 Argument2;
+	typedef A3 Argument3;
+	typedef A4 Argument4;
+	typedef A5 Argument5;
+	typedef A6 Argument6;
+	typedef A7 Argument7;
+	typedef A8 Argument8;
+	typedef A9 Argument9;
+};
+
+
+/**
+ * The part of a method handle that does not depend on its signature.
+ *
+ * A handle keeps a global reference to its class and the resolved jmethodID,
+ * it is immutable and may be shared and copied freely between threads.
+ */
+class JMethodHandleBase
+{
+public:
+	/**
+	 * The kinds of method a handle may refer to.
+	 */
+	enum Kind { Virtual, Static, Constructor };
+
+	/**
+	 * Returns the class the method belongs to.
+	 */
+	jclass getClass() const;
+
+	/**
+	 * Returns the resolved method.
+	 */
+	jmethodID getMethodID() const;
+
+protected:
+	/**
+	 * Resolves the method with the given name and signature in jClass.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	JMethodHandleBase(jclass jClass, const std::string& name, const std::string& signature, Kind kind);
+
+	/**
+	 * Resolves the method with the given name and signature in jClass, through JMemberRegistry.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	JMethodHandleBase(const JClass& jClass, const std::string& name, const std::string& signature, Kind kind);
+
+	/**
+	 * Returns descriptor, once it is checked against the signature computed from the proxy types
+	 * of a handle. Only the number of arguments and the primitive types are compared, as the
+	 * descriptor may name classes that the handle stands in for with JObject.
+	 *
+	 * @throws JNIException if the descriptor does not match.
+	 */
+	static const std::string& checkDescriptor(const std::string& descriptor, const std::string& expected);
+
+private:
+	boost::shared_ptr<_jclass> mClass;
+	jmethodID mMethodID;
+};
+
+
+/**
+ * A typed handle on an instance method, for classes that have no generated proxy.
+ *
+ * The JNI signature is computed from the Signature template argument, so calls
+ * dispatch straight to the matching Call<Type>MethodA function, with no JArguments,
+ * JSignature or virtual calls. For example:
+ *
+ *   JMethodHandle<JInt(String)> indexOf = method<JInt(String)>(pluginClass, "indexOf");
+ *   JInt index = indexOf(plugin, "name");
+ *
+ * Calling a handle with the wrong number of arguments fails to compile.
+ *
+ * The signature can only be computed for proxy types. The JNI descriptor of a method that takes
+ * or returns classes without a proxy may be passed explicitly, with JObject standing in for
+ * those classes in Signature:
+ *
+ *   JMethodHandle<JObject(JObject)> apply = method<JObject(JObject)>(pluginClass, "apply",
+ *     "(Lcom/example/Input;)Lcom/example/Output;");
+ */
+template <class Signature> class JMethodHandle: public JMethodHandleBase
+{
+public:
+	typedef JFunctionTraits<Signature> Traits;
+	typedef typename Traits::Result ResultType;
+
+	/**
+	 * Resolves the method with the given name in jClass.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	JMethodHandle(jclass jClass, const std::string& name):
+		JMethodHandleBase(jClass, name, getSignature(), Virtual)
+	{}
+
+	/**
+	 * Resolves the method with the given name in jClass.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	JMethodHandle(const JClass& jClass, const std::string& name):
+		JMethodHandleBase(jClass, name, getSignature(), Virtual)
+	{}
+
+	/**
+	 * Resolves the method with the given name and JNI descriptor in jClass.
+	 *
+	 * @throws JNIException if the descriptor does not match Signature, or the method cannot be found.
+	 */
+	JMethodHandle(jclass jClass, const std::string& name, const std::string& descriptor):
+		JMethodHandleBase(jClass, name, checkDescriptor(descriptor, getSignature()), Virtual)
+	{}
+
+	/**
+	 * Resolves the method with the given name and JNI descriptor in jClass.
+	 *
+	 * @throws JNIException if the descriptor does not match Signature, or the method cannot be found.
+	 */
+	JMethodHandle(const JClass& jClass, const std::string& name, const std::string& descriptor):
+		JMethodHandleBase(jClass, name, checkDescriptor(descriptor, getSignature()), Virtual)
+	{}
+
+	/**
+	 * Returns the JNI signature of the method.
+	 */
+	static const std::string& getSignature()
+	{
+		return JMethodSignature<ResultType, typename Traits::Argument0, typename Traits::Argument1, typename Traits::Argument2, typename Traits::Argument3, typename Traits::Argument4, typename Traits::Argument5, typename Traits::Argument6, typename Traits::Argument7, typename Traits::Argument8, typename Traits::Argument9>::toString();
+	}
+
+	/**
+	 * Invokes the method on the supplied object.
+	 *
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	ResultType operator()(const ::jace::proxy::JObject& object) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 0);
+		jvalue arguments[1];
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 1);
+		jvalue arguments[] = { a0 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 2);
+		jvalue arguments[] = { a0, a1 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 3);
+		jvalue arguments[] = { a0, a1, a2 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 4);
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 5);
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 6);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 7);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 8);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7, const typename Traits::Argument8& a8) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 9);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invoke(object, arguments);
+	}
+
+	ResultType operator()(const ::jace::proxy::JObject& object, const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7, const typename Traits::Argument8& a8, const typename Traits::Argument9& a9) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 10);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invoke(object, arguments);
+	}
+
+private:
+	ResultType invoke(const ::jace::proxy::JObject& object, jvalue* arguments) const
+	{
+		JNIEnv* env = attach();
+		typename JMethodCall<ResultType>::JNIResult result =
+			JMethodCall<ResultType>::call(env, static_cast<jobject>(object), getMethodID(), arguments);
+		catchAndThrow(env);
+		return JMethodCall<ResultType>::toResult(env, result);
+	}
+};
+
+
+/**
+ * A typed handle on a static method, for classes that have no generated proxy.
+ *
+ * See JMethodHandle.
+ */
+template <class Signature> class JStaticMethodHandle: public JMethodHandleBase
+{
+public:
+	typedef JFunctionTraits<Signature> Traits;
+	typedef typename Traits::Result ResultType;
+
+	/**
+	 * Resolves the static method with the given name in jClass.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	JStaticMethodHandle(jclass jClass, const std::string& name):
+		JMethodHandleBase(jClass, name, getSignature(), Static)
+	{}
+
+	/**
+	 * Resolves the static method with the given name in jClass.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	JStaticMethodHandle(const JClass& jClass, const std::string& name):
+		JMethodHandleBase(jClass, name, getSignature(), Static)
+	{}
+
+	/**
+	 * Resolves the static method with the given name and JNI descriptor in jClass.
+	 *
+	 * @throws JNIException if the descriptor does not match Signature, or the method cannot be found.
+	 */
+	JStaticMethodHandle(jclass jClass, const std::string& name, const std::string& descriptor):
+		JMethodHandleBase(jClass, name, checkDescriptor(descriptor, getSignature()), Static)
+	{}
+
+	/**
+	 * Resolves the static method with the given name and JNI descriptor in jClass.
+	 *
+	 * @throws JNIException if the descriptor does not match Signature, or the method cannot be found.
+	 */
+	JStaticMethodHandle(const JClass& jClass, const std::string& name, const std::string& descriptor):
+		JMethodHandleBase(jClass, name, checkDescriptor(descriptor, getSignature()), Static)
+	{}
+
+	/**
+	 * Returns the JNI signature of the method.
+	 */
+	static const std::string& getSignature()
+	{
+		return JMethodSignature<ResultType, typename Traits::Argument0, typename Traits::Argument1, typename Traits::Argument2, typename Traits::Argument3, typename Traits::Argument4, typename Traits::Argument5, typename Traits::Argument6, typename Traits::Argument7, typename Traits::Argument8, typename Traits::Argument9>::toString();
+	}
+
+	/**
+	 * Invokes the method.
+	 *
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	ResultType operator()() const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 0);
+		jvalue arguments[1];
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 1);
+		jvalue arguments[] = { a0 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 2);
+		jvalue arguments[] = { a0, a1 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 3);
+		jvalue arguments[] = { a0, a1, a2 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 4);
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 5);
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 6);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 7);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 8);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7, const typename Traits::Argument8& a8) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 9);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7, const typename Traits::Argument8& a8, const typename Traits::Argument9& a9) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 10);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invoke(arguments);
+	}
+
+private:
+	ResultType invoke(jvalue* arguments) const
+	{
+		JNIEnv* env = attach();
+		typename JMethodCall<ResultType>::JNIResult result =
+			JMethodCall<ResultType>::callStatic(env, getClass(), getMethodID(), arguments);
+		catchAndThrow(env);
+		return JMethodCall<ResultType>::toResult(env, result);
+	}
+};
+
+
+/**
+ * A typed handle on a constructor, for classes that have no generated proxy.
+ *
+ * The result type of Signature is the proxy the new object is returned as,
+ * such as JObject(String). See JMethodHandle.
+ */
+template <class Signature> class JConstructorHandle: public JMethodHandleBase
+{
+public:
+	typedef JFunctionTraits<Signature> Traits;
+	typedef typename Traits::Result ResultType;
+
+	/**
+	 * Resolves the constructor of jClass.
+	 *
+	 * @throws JNIException if the constructor cannot be found.
+	 */
+	explicit JConstructorHandle(jclass jClass):
+		JMethodHandleBase(jClass, "<init>", getSignature(), Constructor)
+	{}
+
+	/**
+	 * Resolves the constructor of jClass.
+	 *
+	 * @throws JNIException if the constructor cannot be found.
+	 */
+	explicit JConstructorHandle(const JClass& jClass):
+		JMethodHandleBase(jClass, "<init>", getSignature(), Constructor)
+	{}
+
+	/**
+	 * Resolves the constructor of jClass with the given JNI descriptor.
+	 *
+	 * @throws JNIException if the descriptor does not match Signature, or the constructor cannot be found.
+	 */
+	JConstructorHandle(jclass jClass, const std::string& descriptor):
+		JMethodHandleBase(jClass, "<init>", checkDescriptor(descriptor, getSignature()), Constructor)
+	{}
+
+	/**
+	 * Resolves the constructor of jClass with the given JNI descriptor.
+	 *
+	 * @throws JNIException if the descriptor does not match Signature, or the constructor cannot be found.
+	 */
+	JConstructorHandle(const JClass& jClass, const std::string& descriptor):
+		JMethodHandleBase(jClass, "<init>", checkDescriptor(descriptor, getSignature()), Constructor)
+	{}
+
+	/**
+	 * Returns the JNI signature of the constructor.
+	 */
+	static const std::string& getSignature()
+	{
+		return JMethodSignature< ::jace::proxy::types::JVoid, typename Traits::Argument0, typename Traits::Argument1, typename Traits::Argument2, typename Traits::Argument3, typename Traits::Argument4, typename Traits::Argument5, typename Traits::Argument6, typename Traits::Argument7, typename Traits::Argument8, typename Traits::Argument9>::toString();
+	}
+
+	/**
+	 * Constructs a new object.
+	 *
+	 * @throws a matching C++ proxy, if a java exception is thrown by the constructor.
+	 */
+	ResultType operator()() const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 0);
+		jvalue arguments[1];
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 1);
+		jvalue arguments[] = { a0 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 2);
+		jvalue arguments[] = { a0, a1 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 3);
+		jvalue arguments[] = { a0, a1, a2 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 4);
+		jvalue arguments[] = { a0, a1, a2, a3 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 5);
+		jvalue arguments[] = { a0, a1, a2, a3, a4 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 6);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 7);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 8);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7, const typename Traits::Argument8& a8) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 9);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8 };
+		return invoke(arguments);
+	}
+
+	ResultType operator()(const typename Traits::Argument0& a0, const typename Traits::Argument1& a1, const typename Traits::Argument2& a2, const typename Traits::Argument3& a3, const typename Traits::Argument4& a4, const typename Traits::Argument5& a5, const typename Traits::Argument6& a6, const typename Traits::Argument7& a7, const typename Traits::Argument8& a8, const typename Traits::Argument9& a9) const
+	{
+		BOOST_STATIC_ASSERT(Traits::arity == 10);
+		jvalue arguments[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+		return invoke(arguments);
+	}
+
+private:
+	ResultType invoke(jvalue* arguments) const
+	{
+		JNIEnv* env = attach();
+		jvalue result;
+		result.l = env->NewObjectA(getClass(), getMethodID(), arguments);
+		catchAndThrow(env);
+		return JMethodCall<ResultType>::toResult(env, result);
+	}
+};
+
+
+/**
+ * Returns a handle on the instance method with the given name and Signature, such as
+ *
+ *   method<JVoid(String, JInt)>(jClass, "put")
+ *
+ * @throws JNIException if the method cannot be found.
+ */
+template <class Signature>
+JMethodHandle<Signature> method(jclass jClass, const std::string& name)
+{
+	return JMethodHandle<Signature>(jClass, name);
+}
+
+template <class Signature>
+JMethodHandle<Signature> method(const JClass& jClass, const std::string& name)
+{
+	return JMethodHandle<Signature>(jClass, name);
+}
+
+/**
+ * Returns a handle on the instance method with the given name and JNI descriptor, for methods
+ * whose signature names classes without a proxy, such as
+ *
+ *   method<JObject(JObject)>(jClass, "apply", "(Lcom/example/Input;)Lcom/example/Output;")
+ *
+ * @throws JNIException if the descriptor does not match Signature, or the method cannot be found.
+ */
+template <class Signature>
+JMethodHandle<Signature> method(jclass jClass, const std::string& name, const std::string& descriptor)
+{
+	return JMethodHandle<Signature>(jClass, name, descriptor);
+}
+
+template <class Signature>
+JMethodHandle<Signature> method(const JClass& jClass, const std::string& name, const std::string& descriptor)
+{
+	return JMethodHandle<Signature>(jClass, name, descriptor);
+}
+
+/**
+ * Returns a handle on the static method with the given name and Signature.
+ *
+ * @throws JNIException if the method cannot be found.
+ */
+template <class Signature>
+JStaticMethodHandle<Signature> static_method(jclass jClass, const std::string& name)
+{
+	return JStaticMethodHandle<Signature>(jClass, name);
+}
+
+template <class Signature>
+JStaticMethodHandle<Signature> static_method(const JClass& jClass, const std::string& name)
+{
+	return JStaticMethodHandle<Signature>(jClass, name);
+}
+
+/**
+ * Returns a handle on the static method with the given name and JNI descriptor.
+ *
+ * @throws JNIException if the descriptor does not match Signature, or the method cannot be found.
+ */
+template <class Signature>
+JStaticMethodHandle<Signature> static_method(jclass jClass, const std::string& name, const std::string& descriptor)
+{
+	return JStaticMethodHandle<Signature>(jClass, name, descriptor);
+}
+
+template <class Signature>
+JStaticMethodHandle<Signature> static_method(const JClass& jClass, const std::string& name,
+	const std::string& descriptor)
+{
+	return JStaticMethodHandle<Signature>(jClass, name, descriptor);
+}
+
+/**
+ * Returns a handle on the constructor with the given Signature, such as
+ *
+ *   constructor<JObject(String)>(jClass)
+ *
+ * @throws JNIException if the constructor cannot be found.
+ */
+template <class Signature>
+JConstructorHandle<Signature> constructor(jclass jClass)
+{
+	return JConstructorHandle<Signature>(jClass);
+}
+
+template <class Signature>
+JConstructorHandle<Signature> constructor(const JClass& jClass)
+{
+	return JConstructorHandle<Signature>(jClass);
+}
+
+/**
+ * Returns a handle on the constructor with the given JNI descriptor.
+ *
+ * @throws JNIException if the descriptor does not match Signature, or the constructor cannot be found.
+ */
+template <class Signature>
+JConstructorHandle<Signature> constructor(jclass jClass, const std::string& descriptor)
+{
+	return JConstructorHandle<Signature>(jClass, descriptor);
+}
+
+template <class Signature>
+JConstructorHandle<Signature> constructor(const JClass& jClass, const std::string& descriptor)
+{
+	return JConstructorHandle<Signature>(jClass, descriptor);
+}
+
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JMETHOD_HANDLE_H
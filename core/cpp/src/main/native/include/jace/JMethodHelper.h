@@ -0,0 +1,149 @@
+#ifndef JACE_JMETHOD_HELPER_H
+#define JACE_JMETHOD_HELPER_H
+
+#include "jace/Namespace.h"
+#include "jace/JClass.h"
+#include "jace/JResult.h"
+#include "jace/JTypeKind.h"
+
+#include <jni.h>
+
+#include <string>
+
+#include <boost/atomic.hpp>
+
+BEGIN_NAMESPACE_2(jace, proxy)
+class JObject;
+class JValue;
+END_NAMESPACE_2(jace, proxy)
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * The type-independent part of JMethod.
+ *
+ * JMethod is a thin typed wrapper around this class, which looks up the method
+ * and makes the JNI call according to the JTypeKind of the result. The call
+ * machinery therefore exists once in the library, rather than once per proxy type.
+ *
+ * This class is internal to the JACE library.
+ */
+class JMethodHelper
+{
+public:
+	/**
+	 * Returns the JClass of a type, such as ResultType::staticGetJavaJniClass.
+	 *
+	 * Only called when the signature of the method has to be computed.
+	 */
+	typedef const ::jace::JClass& (*ClassGetter)();
+
+	/**
+	 * Creates a new JMethodHelper for the method with the given name.
+	 *
+	 * @param declaringClass the class to look the method up in, or null to use
+	 * the class of the first object (or class) the method is invoked on
+	 * @param signature the JNI signature of the method, or an empty string
+	 * to compute it from the runtime types of the arguments
+	 */
+	JMethodHelper(const std::string& name, const ::jace::JClass* declaringClass, const std::string& signature);
+
+	/**
+	 * Creates a copy of an existing JMethodHelper, including its cached jmethodID.
+	 */
+	JMethodHelper(const JMethodHelper& other);
+
+	/**
+	 * Calls a method, through the Call<Type>MethodA function matching kind.
+	 *
+	 * Any java exception is left pending. An ObjectKind result is a local reference.
+	 */
+	static jvalue call(JNIEnv* env, JTypeKind kind, jobject object, jmethodID methodID, jvalue* arguments);
+
+	/**
+	 * Calls a static method, through the CallStatic<Type>MethodA function matching kind.
+	 *
+	 * Any java exception is left pending. An ObjectKind result is a local reference.
+	 */
+	static jvalue callStatic(JNIEnv* env, JTypeKind kind, jclass jClass, jmethodID methodID, jvalue* arguments);
+
+	/**
+	 * Releases a result that is not needed, by deleting its local reference if it has one.
+	 */
+	static void release(JNIEnv* env, JTypeKind kind, jvalue result);
+
+	/**
+	 * Invokes the method on the supplied object.
+	 *
+	 * @return the result, as a local reference for ObjectKind
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	jvalue invoke(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const ::jace::proxy::JObject& object,
+		const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count);
+
+	/**
+	 * Invokes the method statically, on the supplied class.
+	 *
+	 * @return the result, as a local reference for ObjectKind
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 * @throws a matching C++ proxy, if a java exception is thrown by the method.
+	 */
+	jvalue invokeStatic(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const ::jace::JClass& jClass,
+		const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count);
+
+	/**
+	 * Invokes the method on the supplied object, storing any java exception it throws in error.
+	 *
+	 * @return the result, as a local reference for ObjectKind. Zero if the method threw an exception.
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 */
+	jvalue tryInvoke(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const ::jace::proxy::JObject& object,
+		const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count, JavaThrowable& error);
+
+	/**
+	 * Invokes the method statically, storing any java exception it throws in error.
+	 *
+	 * @return the result, as a local reference for ObjectKind. Zero if the method threw an exception.
+	 * @throws JNIException if an error occurs while trying to invoke the method.
+	 */
+	jvalue tryInvokeStatic(JNIEnv* env, JTypeKind kind, ClassGetter resultClass, const ::jace::JClass& jClass,
+		const ::jace::proxy::JValue* const* values, jvalue* arguments, size_t count, JavaThrowable& error);
+
+	/**
+	 * Returns the jmethodID matching the signature for the given arguments.
+	 *
+	 * @throws JNIException if the method cannot be found.
+	 */
+	jmethodID getMethodID(const ::jace::JClass& jClass, ClassGetter resultClass,
+		const ::jace::proxy::JValue* const* values, size_t count, bool isStatic)
+	{
+		// We cache the jmethodID locally, so if we've already found it, we don't need to go looking for it again.
+		jmethodID methodID = mMethodID.load(boost::memory_order_acquire);
+		if (methodID)
+			return methodID;
+		return lookupMethodID(jClass, resultClass, values, count, isStatic);
+	}
+
+private:
+	/**
+	 * Prevent assignment.
+	 */
+	JMethodHelper& operator=(const JMethodHelper&);
+
+	/**
+	 * Looks up the jmethodID, and caches it.
+	 */
+	jmethodID lookupMethodID(const ::jace::JClass& jClass, ClassGetter resultClass,
+		const ::jace::proxy::JValue* const* values, size_t count, bool isStatic);
+
+	const std::string mName;
+	const ::jace::JClass* mClass;
+	const std::string mSignature;
+	boost::atomic<jmethodID> mMethodID;
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JMETHOD_HELPER_H
@@ -0,0 +1,181 @@
+#ifndef JACE_JRESULT_H
+#define JACE_JRESULT_H
+
+#include "jace/Namespace.h"
+#include "jace/JClass.h"
+
+#include <jni.h>
+
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * Selects the overloads of generated proxy methods that return a JResult
+ * instead of throwing java exceptions as C++ exceptions.
+ *
+ * For example:
+ *
+ *   JResult<JInt> result = Integer::parseInt(jace::nothrow, text);
+ *   if (!result.hasValue())
+ *     ...
+ */
+struct nothrow_t
+{};
+
+extern const nothrow_t nothrow;
+
+
+/**
+ * A java exception that was caught without being translated into a C++ proxy exception.
+ *
+ * Holds a global reference to the throwable, which is shared between copies.
+ */
+class JavaThrowable
+{
+public:
+	/**
+	 * Creates a null JavaThrowable, representing the absence of an exception.
+	 */
+	JavaThrowable();
+
+	/**
+	 * Creates a JavaThrowable holding a new global reference to the given throwable.
+	 */
+	explicit JavaThrowable(jthrowable throwable);
+
+	/**
+	 * Clears the exception pending on the current thread, if any, and returns it.
+	 *
+	 * Unlike catchAndThrow(), this does not look up the matching C++ proxy,
+	 * nor throw anything.
+	 *
+	 * @return a null JavaThrowable if no exception is pending
+	 */
+	static JavaThrowable takePending(JNIEnv* env);
+
+	/**
+	 * Returns true if this JavaThrowable does not hold an exception.
+	 */
+	bool isNull() const;
+
+	/**
+	 * Returns the global reference to the throwable.
+	 */
+	jthrowable getThrowable() const;
+
+	/**
+	 * Returns true if the throwable is an instance of the given class.
+	 */
+	bool isInstanceOf(const ::jace::JClass& jClass) const;
+
+	/**
+	 * Returns the fully qualified name of the class of the throwable, such as
+	 * "java.lang.NumberFormatException".
+	 */
+	std::string getClassName() const;
+
+	/**
+	 * Returns the result of Throwable.getMessage(), or an empty string if it is null.
+	 */
+	std::string getMessage() const;
+
+	/**
+	 * Returns a proxy for the throwable, such as ::jace::proxy::java::lang::Throwable.
+	 */
+	template <class T> T as() const
+	{
+		return T(static_cast<jobject>(getThrowable()));
+	}
+
+	/**
+	 * Throws the matching C++ proxy exception, as catchAndThrow() would have.
+	 *
+	 * @throws JNIException if this JavaThrowable is null.
+	 */
+	void rethrow() const;
+
+private:
+	boost::shared_ptr<_jobject> mThrowable;
+};
+
+
+/**
+ * The result of a method invoked through JMethod::tryInvoke(), or through the
+ * nothrow overload of a generated proxy method.
+ *
+ * Holds either the value returned by the method, or the java exception it threw.
+ * Expected failures can then be handled as an ordinary branch, instead of
+ * paying for the translation into a C++ proxy exception and the unwinding.
+ */
+template <class T> class JResult
+{
+public:
+	/**
+	 * Creates a successful result.
+	 */
+	JResult(const T& value): mValue(value), mError()
+	{}
+
+	/**
+	 * Creates a failed result.
+	 */
+	JResult(const JavaThrowable& error): mValue(), mError(error)
+	{}
+
+	/**
+	 * Returns true if the method returned normally.
+	 */
+	bool hasValue() const
+	{
+		return mValue.is_initialized();
+	}
+
+	/**
+	 * Returns true if the method threw an exception.
+	 */
+	bool hasError() const
+	{
+		return !mValue.is_initialized();
+	}
+
+	/**
+	 * Returns the value returned by the method.
+	 *
+	 * @throws the matching C++ proxy exception, if the method threw one.
+	 */
+	const T& getValue() const
+	{
+		if (!mValue)
+			mError.rethrow();
+		return *mValue;
+	}
+
+	/**
+	 * Returns the value returned by the method, or defaultValue if it threw an exception.
+	 */
+	T getValueOr(const T& defaultValue) const
+	{
+		return mValue ? *mValue : defaultValue;
+	}
+
+	/**
+	 * Returns the exception thrown by the method, or a null JavaThrowable if it returned normally.
+	 */
+	const JavaThrowable& getError() const
+	{
+		return mError;
+	}
+
+private:
+	boost::optional<T> mValue;
+	JavaThrowable mError;
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JRESULT_H
@@ -9,6 +9,18 @@
 
 #include <boost/ref.hpp>
 
+BEGIN_NAMESPACE_3(jace, proxy, types)
+class JBoolean;
+class JByte;
+class JChar;
+class JDouble;
+class JFloat;
+class JInt;
+class JLong;
+class JShort;
+class JVoid;
+END_NAMESPACE_3(jace, proxy, types)
+
 BEGIN_NAMESPACE(jace)
 
 
@@ -69,6 +81,111 @@ private:
 };
 
 
+/**
+ * Marks an unused argument slot in JMethodSignature.
+ */
+class JNoArgument;
+
+
+/**
+ * Returns the JNI signature of the java type represented by the C++ proxy T.
+ *
+ * The signatures of the primitive types are known at compile time. All other types
+ * are taken from T::staticGetJavaJniClass(), which does not require a virtual machine.
+ */
+template <class T> struct JTypeSignature
+{
+	static const std::string& toString() { return T::staticGetJavaJniClass().getSignature(); }
+};
+
+template <> struct JTypeSignature<JNoArgument>
+{
+	static const char* toString() { return ""; }
+};
+
+template <> struct JTypeSignature< ::jace::proxy::types::JBoolean >
+{
+	static const char* toString() { return "Z"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JByte >
+{
+	static const char* toString() { return "B"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JChar >
+{
+	static const char* toString() { return "C"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JDouble >
+{
+	static const char* toString() { return "D"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JFloat >
+{
+	static const char* toString() { return "F"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JInt >
+{
+	static const char* toString() { return "I"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JLong >
+{
+	static const char* toString() { return "J"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JShort >
+{
+	static const char* toString() { return "S"; }
+};
+template <> struct JTypeSignature< ::jace::proxy::types::JVoid >
+{
+	static const char* toString() { return "V"; }
+};
+
+
+/**
+ * The signature of a java method, computed from the C++ proxy types of its
+ * return value and arguments.
+ *
+ * For example,
+ *
+ *   JMethodSignature<JVoid, JInt, String>::toString()
+ *
+ * returns "(ILjava/lang/String;)V".
+ *
+ * The string is built once per combination of types and shared from then on, so
+ * a JMethod or JConstructor given this signature never has to compute it per call
+ * or from the runtime types of its arguments.
+ */
+template <class ResultType, class A0 = JNoArgument, class A1 = JNoArgument, class A2 = JNoArgument, class A3 = JNoArgument, class A4 = JNoArgument, class A5 = JNoArgument, class A6 = JNoArgument, class A7 = JNoArgument, class A8 = JNoArgument, class A9 = JNoArgument>
+class JMethodSignature
+{
+public:
+	static const std::string& toString()
+	{
+		static const std::string result = build();
+		return result;
+	}
+
+private:
+	static std::string build()
+	{
+		std::string result("(");
+		result.append(JTypeSignature<A0>::toString());
+		result.append(JTypeSignature<A1>::toString());
+		result.append(JTypeSignature<A2>::toString());
+		result.append(JTypeSignature<A3>::toString());
+		result.append(JTypeSignature<A4>::toString());
+		result.append(JTypeSignature<A5>::toString());
+		result.append(JTypeSignature<A6>::toString());
+		result.append(JTypeSignature<A7>::toString());
+		result.append(JTypeSignature<A8>::toString());
+		result.append(JTypeSignature<A9>::toString());
+		result.append(")");
+		result.append(JTypeSignature<ResultType>::toString());
+		return result;
+	}
+};
+
+
 END_NAMESPACE(jace)
 
 #endif // #ifndef JACE_JSIGNATURE_H
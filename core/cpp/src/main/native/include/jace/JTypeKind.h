@@ -0,0 +1,65 @@
+#ifndef JACE_JTYPE_KIND_H
+#define JACE_JTYPE_KIND_H
+
+#include "jace/Namespace.h"
+
+BEGIN_NAMESPACE_3(jace, proxy, types)
+class JBoolean;
+class JByte;
+class JChar;
+class JDouble;
+class JFloat;
+class JInt;
+class JLong;
+class JShort;
+class JVoid;
+END_NAMESPACE_3(jace, proxy, types)
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * The JNI kind of a java type.
+ *
+ * The kind selects which Call<Type>Method, Get<Type>Field and Set<Type>Field
+ * functions handle the type. All reference types share ObjectKind, so the JNI
+ * code for them exists once in the library, no matter how many proxy types use it.
+ */
+enum JTypeKind
+{
+	ObjectKind,
+	BooleanKind,
+	ByteKind,
+	CharKind,
+	ShortKind,
+	IntKind,
+	LongKind,
+	FloatKind,
+	DoubleKind,
+	VoidKind
+};
+
+
+/**
+ * Maps a proxy type to its JTypeKind.
+ *
+ * The primary template handles reference types.
+ */
+template <class T> struct JTypeKindOf
+{
+	enum { value = ObjectKind };
+};
+
+template <> struct JTypeKindOf< ::jace::proxy::types::JBoolean > { enum { value = BooleanKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JByte > { enum { value = ByteKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JChar > { enum { value = CharKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JShort > { enum { value = ShortKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JInt > { enum { value = IntKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JLong > { enum { value = LongKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JFloat > { enum { value = FloatKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JDouble > { enum { value = DoubleKind }; };
+template <> struct JTypeKindOf< ::jace::proxy::types::JVoid > { enum { value = VoidKind }; };
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JTYPE_KIND_H
@@ -76,6 +76,10 @@ JavaVM* getJavaVm();
  *
  * This method is equivilent to attach(0, 0, false).
  *
+ * The JNIEnv is cached per thread, so once a thread is attached this method
+ * does not lock. Threads attached through attach() must be detached through
+ * detach(), rather than by calling DetachCurrentThread() directly.
+ *
  * @throws JNIException if an error occurs while trying to attach the current thread.
  * @see AttachCurrentThread
  * @see attach(const jobject, const char*, const bool)
@@ -84,6 +88,42 @@ JavaVM* getJavaVm();
  */
 JNIEnv* attach() /* throw (VirtualMachineShutdownError, JNIException) */;
 
+/**
+ * Attaches the current thread to the virtual machine under the given name and
+ * thread group, and returns the appropriate JNIEnv for the thread. If the thread
+ * is already attached, this method does nothing, and its name and daemon status
+ * remain unchanged.
+ *
+ * Long-lived threads that know they will make JNI calls, such as the workers of
+ * a JvmExecutor, can use this to attach up front under a meaningful name.
+ *
+ * @param threadGroup the java thread group of the thread, or null for the main thread group
+ * @param name the name of the java thread, or null for a default name
+ * @param daemon true if the thread should be attached as a daemon thread, which
+ * does not keep the virtual machine from shutting down
+ * @see AttachCurrentThread
+ * @see AttachCurrentThreadAsDaemon
+ * @throws JNIException if an error occurs while attaching the current thread
+ * @throws VirtualMachineShutdownError if the virtual machine is not running
+ */
+JNIEnv* attach(const jobject threadGroup, const char* name, const bool daemon) /* throw (VirtualMachineShutdownError, JNIException) */;
+
+/**
+ * Selects the overloads of generated proxy methods that take the JNIEnv of the caller,
+ * instead of attaching the current thread.
+ *
+ * For example:
+ *
+ *   buffer.position(jace::with_env, env, 0);
+ *
+ * A tag is used rather than a leading JNIEnv* parameter, as a literal 0 is a null pointer
+ * constant: buffer.position(0) would otherwise call the JNIEnv* overload with a null env.
+ */
+struct with_env_t
+{};
+
+extern const with_env_t with_env;
+
 /**
  * Detaches the current thread from the virtual machine.
  *
@@ -99,11 +139,23 @@ void detach();
  */
 jobject newLocalRef(jobject ref) /* throw (VirtualMachineShutdownError, JNIException) */;
 
+/**
+ * Allocates a new local reference in the given JNIEnv, which must belong to the current thread.
+ *
+ * @throws JNIException if the local reference can not be allocated.
+ */
+jobject newLocalRef(JNIEnv* env, jobject ref) /* throw (JNIException) */;
+
 /**
  * A central point for deleting local references.
  */
 void deleteLocalRef(jobject localRef);
 
+/**
+ * Deletes a local reference in the given JNIEnv, which must belong to the current thread.
+ */
+void deleteLocalRef(JNIEnv* env, jobject localRef);
+
 
 /**
  * A central point for allocating new global references.
@@ -114,11 +166,92 @@ void deleteLocalRef(jobject localRef);
  */
 jobject newGlobalRef(jobject ref) /* throw (VirtualMachineShutdownError, JNIException)*/;
 
+/**
+ * Allocates a new global reference through the given JNIEnv, which must belong to the current thread.
+ *
+ * @throws JNIException if the global reference can not be allocated.
+ */
+jobject newGlobalRef(JNIEnv* env, jobject ref) /* throw (JNIException)*/;
+
 /**
  * A central point for deleting global references.
  */
 void deleteGlobalRef(jobject globalRef);
 
+/**
+ * Deletes a global reference through the given JNIEnv, which must belong to the current thread.
+ */
+void deleteGlobalRef(JNIEnv* env, jobject globalRef);
+
+/**
+ * A central point for allocating new weak global references, which do not keep
+ * their object from being garbage collected.
+ * These references must be deallocated by a call to deleteWeakGlobalRef.
+ *
+ * @return null if ref is null, or is a weak reference whose object has been collected.
+ * @throws JNIException if the weak global reference can not be allocated.
+ */
+jobject newWeakGlobalRef(JNIEnv* env, jobject ref) /* throw (JNIException)*/;
+
+/**
+ * A central point for deleting weak global references.
+ */
+void deleteWeakGlobalRef(jobject weakRef);
+
+/**
+ * Returns the identity hash code of an object, as System.identityHashCode() does.
+ *
+ * @throws JNIException if System.identityHashCode() can not be called.
+ */
+jint identityHashCode(JNIEnv* env, jobject object) /* throw (JNIException)*/;
+
+/**
+ * Releases a global reference that a proxy no longer needs.
+ *
+ * The reference is deleted right away, unless deferred reclamation is enabled, in which
+ * case it is queued without entering the virtual machine, and deleted later by
+ * reclaimGlobalRefs(). Used by the destructors of JObject, ElementProxy and JFieldProxy.
+ *
+ * @see setDeferredReclamation
+ */
+void releaseGlobalRef(jobject globalRef);
+
+/**
+ * Enables or disables deferred reclamation of global references.
+ *
+ * Once enabled, destroying a proxy never enters the virtual machine, and never attaches
+ * the destroying thread to it: the global reference of the proxy is queued on a lock-free
+ * queue instead. Queued references are deleted in bulk, by the next call to attach() on an
+ * attached thread once enough of them have accumulated, or by an explicit call to
+ * reclaimGlobalRefs(), for example from a periodic task on a JvmExecutor.
+ *
+ * Disabled by default. Disabling it does not delete the references already queued.
+ * While it is enabled, attach() must not be called inside a JNI critical region, such as
+ * between GetPrimitiveArrayCritical() and ReleasePrimitiveArrayCritical().
+ */
+void setDeferredReclamation(bool enabled);
+
+/**
+ * Returns true if deferred reclamation of global references is enabled.
+ */
+bool isDeferredReclamation();
+
+/**
+ * Deletes the global references queued by releaseGlobalRef(), on any thread.
+ *
+ * @return the number of references deleted
+ * @throws VirtualMachineShutdownError if the virtual machine is not running
+ */
+size_t reclaimGlobalRefs() /* throw (VirtualMachineShutdownError) */;
+
+/**
+ * Deletes the global references queued by releaseGlobalRef(), through the given JNIEnv,
+ * which must belong to the current thread.
+ *
+ * @return the number of references deleted
+ */
+size_t reclaimGlobalRefs(JNIEnv* env);
+
 
 /**
  * Enlists a new factory for a java class with Jace.
@@ -145,6 +278,14 @@ void enlist(JFactory* factory);
  */
 void catchAndThrow();
 
+/**
+ * Checks to see if a java exception has been thrown on the given JNIEnv,
+ * which must belong to the current thread.
+ *
+ * Code that already holds the JNIEnv can call this to skip attach().
+ */
+void catchAndThrow(JNIEnv* env);
+
 /** Modifies the given exception to include the underlying exception, if there is one.  Returns true if there was one */
 inline bool messageException(std::string& msg) {
     try { 
@@ -350,13 +491,14 @@ T java_new(const ::std::string& text) {
  * For example,
  *
  *  Object stringAsObject = String("Hello");
- *  String string = java_cast<String>(stringAsObject);
+ *  String string = java_cast<String>(env, stringAsObject);
+ *
+ * env must belong to the current thread.
  *
  * @throws JNIException if obj is not convertible to type T.
  */
 template <typename T> 
-T java_cast(const ::jace::proxy::JObject& obj) {
-	JNIEnv* env = attach();
+T java_cast(JNIEnv* env, const ::jace::proxy::JObject& obj) {
 	jclass argClass = env->GetObjectClass(obj);
 
 	if (!argClass)
@@ -377,6 +519,18 @@ T java_cast(const ::jace::proxy::JObject& obj) {
 	throw JNIException(msg);
 }
 
+/**
+ * Performs a safe cast from one JObject subclass to another.
+ *
+ * Equivalent to java_cast<T>(attach(), obj).
+ *
+ * @throws JNIException if obj is not convertible to type T.
+ */
+template <typename T> 
+T java_cast(const ::jace::proxy::JObject& obj) {
+	return java_cast<T>(attach(), obj);
+}
+
 /** Throws a java exception with the given message */
 void java_throw(const std::string& internalName, const std::string& message);
 
@@ -422,18 +576,18 @@ jobject java_box(T val) {
  *
  *  Object stringAsObject = String("Hello");
  *
- *  if (instanceof<String>(stringAsObject))
- *    String str = java_cast<String>(stringAsObject);
+ *  if (instanceof<String>(env, stringAsObject))
+ *    String str = java_cast<String>(env, stringAsObject);
  *
+ * env must belong to the current thread.
  *
  * @throws JNIException if obj is not convertible to type T.
  */
 template <typename T> 
-bool instanceof(const ::jace::proxy::JObject& object) {
+bool instanceof(JNIEnv* env, const ::jace::proxy::JObject& object) {
 	if (object.isNull())
 		return false;
 
-	JNIEnv* env = attach();
 	jclass argClass = env->GetObjectClass(object);
 
 	if (!argClass)
@@ -450,6 +604,18 @@ bool instanceof(const ::jace::proxy::JObject& object) {
 	return isValid;
 }
 
+/**
+ * Equal to Java's instanceof keyword.
+ *
+ * Equivalent to instanceof<T>(attach(), object).
+ */
+template <typename T> 
+bool instanceof(const ::jace::proxy::JObject& object) {
+	if (object.isNull())
+		return false;
+	return instanceof<T>(attach(), object);
+}
+
 END_NAMESPACE(jace)
 
 #endif
@@ -0,0 +1,201 @@
+#ifndef JACE_JVM_EXECUTOR_H
+#define JACE_JVM_EXECUTOR_H
+
+#include "jace/Namespace.h"
+
+#include <jni.h>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A pool of threads that are attached to the virtual machine once, when the pool starts,
+ * and stay attached until it shuts down.
+ *
+ * Tasks that make JNI calls can be submitted from any thread. They never pay for
+ * AttachCurrentThread(), unlike tasks run on threads that come and go. Each worker has
+ * its own queue: a worker runs its most recently queued task first, and steals the
+ * oldest task of another worker when its own queue is empty.
+ *
+ * For example:
+ *
+ *   void parse(JNIEnv* env, String text);
+ *
+ *   JvmExecutor executor(4);
+ *   executor.submit(boost::bind(&parse, _1, text));
+ *
+ * Each task runs inside its own local reference frame, so the local references it creates
+ * are released when it returns. A java exception left pending by a task is cleared.
+ * A task is dropped without running if its worker can no longer reach the virtual machine,
+ * or its local reference frame cannot be allocated.
+ * A task that throws boost::thread_interrupted ends its worker, whose queued tasks are
+ * then run by the other workers.
+ *
+ * An executor may be given a capacity, which bounds the number of queued tasks. Once it
+ * is reached, submit() blocks until a worker takes a task, and trySubmit() fails, so
+ * that producers slow down to the pace of the workers instead of queueing without bound.
+ */
+class JvmExecutor: public boost::noncopyable
+{
+public:
+	/**
+	 * A task, which is passed the JNIEnv of the worker running it.
+	 */
+	typedef boost::function<void (JNIEnv*)> Task;
+
+	/**
+	 * Starts the workers, and attaches them to the virtual machine.
+	 *
+	 * @param threads the number of workers, or 0 for one per hardware thread
+	 * @param daemon true if the workers should be attached as daemon threads, which
+	 * do not keep the virtual machine from shutting down
+	 * @param namePrefix the prefix of the java thread names of the workers,
+	 * which are numbered from 0
+	 * @param capacity the maximum number of queued tasks, or 0 for no limit
+	 * @throws JNIException if a worker cannot be attached to the virtual machine
+	 */
+	explicit JvmExecutor(size_t threads = 0, bool daemon = true,
+		const std::string& namePrefix = "JvmExecutor-", size_t capacity = 0);
+
+	/**
+	 * Runs the remaining tasks, and stops the workers.
+	 *
+	 * An executor must not be destroyed by one of its own workers, which can not join
+	 * themselves. Doing so fails an assertion. In builds without assertions, the workers
+	 * are detached instead of being stopped, and keep referring to the destroyed executor.
+	 */
+	~JvmExecutor();
+
+	/**
+	 * Queues a task.
+	 *
+	 * A task submitted by a worker of this executor is queued on that worker,
+	 * other tasks are spread over the workers.
+	 *
+	 * Exceptions thrown by the task are discarded, tasks that need to report
+	 * failures must catch them.
+	 *
+	 * If the executor is at capacity, blocks until a worker takes a task. Workers
+	 * of this executor never block, to keep them from waiting on themselves.
+	 *
+	 * @throws JNIException if the executor has been shut down
+	 */
+	void submit(const Task& task);
+
+	/**
+	 * Queues a task, unless the executor is at capacity.
+	 *
+	 * @return false if the task was not queued, because the executor is at capacity
+	 * @throws JNIException if the executor has been shut down
+	 */
+	bool trySubmit(const Task& task);
+
+	/**
+	 * Runs the remaining tasks, and stops the workers. Does nothing if the
+	 * executor has already been shut down.
+	 *
+	 * @throws JNIException if called by a worker of this executor
+	 */
+	void shutdown();
+
+	/**
+	 * Returns the number of workers.
+	 */
+	size_t size() const;
+
+	/**
+	 * Returns the maximum number of queued tasks, or 0 if there is no limit.
+	 */
+	size_t capacity() const;
+
+	/**
+	 * Returns true if the calling thread is a worker of this executor.
+	 */
+	bool isWorkerThread() const;
+
+private:
+	/**
+	 * A worker thread, and its queue of tasks.
+	 */
+	struct Worker
+	{
+		JvmExecutor* executor;
+		size_t index;
+		boost::mutex mutex;
+		std::deque<Task> tasks;
+		boost::thread thread;
+	};
+
+	/**
+	 * The body of a worker thread.
+	 */
+	void run(Worker* worker, bool daemon, const std::string& name);
+
+	/**
+	 * Queues a task, waiting for room if block is true.
+	 *
+	 * @return false if the executor is at capacity, and block is false
+	 */
+	bool enqueue(const Task& task, bool block);
+
+	/**
+	 * Takes the next task of the worker, stealing one from another worker if its queue is empty.
+	 *
+	 * @return false if there are no tasks
+	 */
+	bool take(Worker* worker, Task& task);
+
+	/**
+	 * Runs a task inside a local reference frame.
+	 */
+	static void execute(JNIEnv* env, const Task& task);
+
+	std::vector<boost::shared_ptr<Worker> > mWorkers;
+
+	/**
+	 * The number of queued tasks, and the maximum.
+	 */
+	boost::atomic<size_t> mPending;
+	const size_t mCapacity;
+
+	/**
+	 * The workers that are out of tasks wait on mIdle.
+	 */
+	boost::mutex mIdleMutex;
+	boost::condition_variable mIdle;
+	bool mStopping;
+
+	/**
+	 * Producers wait on mNotFull while the executor is at capacity.
+	 */
+	boost::condition_variable mNotFull;
+
+	/**
+	 * The workers report on mStarted once they have attached, or failed to.
+	 */
+	boost::condition_variable mStarted;
+	size_t mStartedCount;
+	std::string mStartError;
+
+	/**
+	 * Spreads the tasks submitted from outside the pool over the workers.
+	 */
+	boost::atomic<size_t> mNextWorker;
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_JVM_EXECUTOR_H
@@ -0,0 +1,108 @@
+#ifndef JACE_LOCAL_H
+#define JACE_LOCAL_H
+
+#include "jace/Namespace.h"
+#include "jace/proxy/JObject.h"
+
+#include <jni.h>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A proxy that borrows a local reference, instead of owning a global reference.
+ *
+ * A Local<T> is a T, so every method of the proxy can be called on it, and it can be passed
+ * wherever a T is expected, but creating, copying and destroying it makes no JNI calls.
+ * This makes it suited to hot loops that work within a single native frame.
+ *
+ * A JMethod< Local<T> > returns its results as Locals too, without promoting them to global
+ * references. For example:
+ *
+ *   static JMethod< Local<String> > getName(Node::staticGetJavaJniClass(), "getName", "()Ljava/lang/String;");
+ *
+ *   for (int i = 0; i < length; ++i)
+ *   {
+ *     Local<Node> node(env->GetObjectArrayElement(nodes, i));
+ *     Local<String> name = getName.invoke(env, node);
+ *     ...
+ *     env->DeleteLocalRef(name.get());
+ *     env->DeleteLocalRef(node.get());
+ *   }
+ *
+ * The local reference stays owned by the caller: it must be deleted by the caller, or released
+ * when the native method returns, and the Local must not be used once it has been. Use global()
+ * to keep the object beyond that.
+ *
+ * Methods of T that return objects still return owning proxies.
+ */
+template <class T> class Local: public T
+{
+public:
+	/**
+	 * Borrows a local reference. The reference may be null.
+	 */
+	explicit Local(jobject ref): T()
+	{
+		this->borrowJavaJniObject(ref);
+	}
+
+	/**
+	 * Borrows the same local reference as another Local.
+	 */
+	Local(const Local& other): T()
+	{
+		this->borrowJavaJniObject(other.get());
+	}
+
+	/**
+	 * Borrows the same local reference as another Local.
+	 */
+	Local& operator=(const Local& other)
+	{
+		this->borrowJavaJniObject(other.get());
+		return *this;
+	}
+
+	/**
+	 * Returns the reference, which is left to the caller.
+	 */
+	~Local() throw ()
+	{
+		this->borrowJavaJniObject(0);
+	}
+
+	/**
+	 * Returns the borrowed local reference.
+	 */
+	jobject get() const
+	{
+		return static_cast<jobject>(static_cast<const ::jace::proxy::JObject&>(*this));
+	}
+
+	/**
+	 * Returns a proxy owning a new global reference to the object, which may outlive the local reference.
+	 */
+	T global() const
+	{
+		return T(get());
+	}
+};
+
+
+/**
+ * Indicates whether a proxy type is a Local.
+ */
+template <class T> struct IsLocal
+{
+	enum { value = 0 };
+};
+
+template <class T> struct IsLocal< Local<T> >
+{
+	enum { value = 1 };
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_LOCAL_H
@@ -0,0 +1,95 @@
+#ifndef JACE_LOCAL_FRAME_H
+#define JACE_LOCAL_FRAME_H
+
+#include "jace/Namespace.h"
+
+#include <jni.h>
+
+#include <boost/utility.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A local reference frame, which is pushed when the LocalFrame is created, and popped when
+ * it is destroyed.
+ *
+ * Popping a frame releases every local reference created inside it at once, which is cheaper
+ * than deleting them one by one, and keeps long loops from running out of local references.
+ * For example:
+ *
+ *   for (int i = 0; i < length; ++i)
+ *   {
+ *     LocalFrame frame(env);
+ *     Local<Node> node(env->GetObjectArrayElement(nodes, i));
+ *     ...
+ *   }
+ *
+ * A result can be carried over to the enclosing frame with pop():
+ *
+ *   LocalFrame frame(env);
+ *   jobject name = ...;
+ *   return frame.pop(name);
+ *
+ * LocalFrames may be nested, and must be destroyed in the reverse order of their creation.
+ */
+class LocalFrame: public boost::noncopyable
+{
+public:
+	/**
+	 * Pushes a frame on the current thread, with room for capacity local references.
+	 * The virtual machine allocates more room as needed.
+	 *
+	 * @throws JNIException if the frame cannot be allocated.
+	 */
+	explicit LocalFrame(jint capacity = 16);
+
+	/**
+	 * Pushes a frame on the thread of the given JNIEnv, with room for capacity local references.
+	 *
+	 * @throws JNIException if the frame cannot be allocated.
+	 */
+	explicit LocalFrame(JNIEnv* env, jint capacity = 16);
+
+	/**
+	 * Pops the frame, unless pop() has already been called.
+	 */
+	~LocalFrame();
+
+	/**
+	 * Pops the frame, releasing the local references created inside it.
+	 *
+	 * @param result a local reference created inside the frame, or null
+	 * @return a new local reference to result, in the enclosing frame, or null
+	 * @throws JNIException if the frame has already been popped.
+	 */
+	jobject pop(jobject result = 0);
+
+	/**
+	 * Returns the JNIEnv of the thread owning the frame.
+	 */
+	JNIEnv* getEnv() const;
+
+private:
+	JNIEnv* mEnv;
+	bool mPopped;
+};
+
+
+/**
+ * Ensures that at least capacity more local references can be created in the current frame.
+ *
+ * @throws JNIException if the virtual machine cannot allocate the room.
+ */
+void ensureLocalCapacity(JNIEnv* env, jint capacity);
+
+/**
+ * Ensures that at least capacity more local references can be created in the current frame.
+ *
+ * @throws JNIException if the virtual machine cannot allocate the room.
+ */
+void ensureLocalCapacity(jint capacity);
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_LOCAL_FRAME_H
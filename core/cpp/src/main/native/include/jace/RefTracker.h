@@ -0,0 +1,136 @@
+#ifndef JACE_REF_TRACKER_H
+#define JACE_REF_TRACKER_H
+
+#include "jace/Namespace.h"
+
+#include <jni.h>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * Accounts for the JNI references created and deleted by Jace, to find reference leaks.
+ *
+ * Accounting is compiled in when Jace is built with JACE_TRACK_REFS defined, and costs nothing
+ * otherwise. It covers newGlobalRef(), deleteGlobalRef(), newLocalRef(), deleteLocalRef(),
+ * the global references that proxies create in JObject::setJavaJniValue(), the local references
+ * returned by JArrayHelper::getElement(), and the references deleted by reclaimGlobalRefs().
+ * The references of classes and NativeProxy::Builder instances, which are kept for the life
+ * of the process, are not counted.
+ *
+ * References are counted by call site, with live counts and high-water marks. Each live global
+ * reference is also recorded, along with the backtrace of its creation if setCaptureBacktraces()
+ * is enabled, so that dump() can break live references down by java class and show where they
+ * were created. resetJavaVm() reports the global references that are still live to std::cerr.
+ *
+ * Local references are only counted, as the virtual machine releases them implicitly when their
+ * frame is popped, without Jace seeing it. Their live count is the number of local references
+ * created and not explicitly deleted, which is an upper bound.
+ *
+ * RefTracker is thread-safe.
+ */
+class RefTracker
+{
+public:
+	/**
+	 * The kinds of reference tracked.
+	 */
+	enum Kind { Global = 0, Local = 1 };
+
+	/**
+	 * The references created at a call site.
+	 */
+	struct Site
+	{
+		Site(): kind(Global), live(0), peak(0), created(0)
+		{}
+
+		std::string name;
+		Kind kind;
+		/** The number of references that are still live, for global references */
+		size_t live;
+		/** The highest number of references that were live at once, for global references */
+		size_t peak;
+		/** The number of references created */
+		unsigned long created;
+	};
+
+	/**
+	 * Returns true if Jace was built with JACE_TRACK_REFS defined.
+	 */
+	static bool isEnabled();
+
+	/**
+	 * Records the creation of a reference at the named call site. Null references are ignored.
+	 *
+	 * @param site a string literal naming the call site, such as "JObject::setJavaJniValue"
+	 */
+	static void created(Kind kind, jobject ref, const char* site);
+
+	/**
+	 * Records the deletion of a reference. References that were not recorded are ignored.
+	 */
+	static void deleted(Kind kind, jobject ref);
+
+	/**
+	 * Enables or disables capturing the backtrace of each new global reference.
+	 * Disabled by default, as it is slow. Only supported on glibc.
+	 */
+	static void setCaptureBacktraces(bool enabled);
+
+	/**
+	 * Returns the number of references of a kind that are live.
+	 */
+	static size_t live(Kind kind);
+
+	/**
+	 * Returns the highest number of references of a kind that were live at once.
+	 */
+	static size_t peak(Kind kind);
+
+	/**
+	 * Returns the call sites that created references, in the order of their names.
+	 */
+	static std::vector<Site> getSites();
+
+	/**
+	 * Writes the live counts and high-water marks of every call site to out.
+	 *
+	 * If the virtual machine is running, the live global references are also broken down by
+	 * java class, and the backtraces of up to maxBacktraces of them are written.
+	 */
+	static void dump(std::ostream& out, size_t maxBacktraces = 10);
+
+	/**
+	 * Writes a report to out if any global reference is live.
+	 *
+	 * @return the number of live global references
+	 */
+	static size_t check(std::ostream& out);
+
+	/**
+	 * Forgets every reference and call site. Called by resetJavaVm(), once the references
+	 * of the virtual machine have gone away with it.
+	 */
+	static void reset();
+};
+
+END_NAMESPACE(jace)
+
+
+/**
+ * Records the creation and deletion of references, in builds with JACE_TRACK_REFS defined.
+ */
+#ifdef JACE_TRACK_REFS
+	#define JACE_REF_CREATED(kind, ref, site) ::jace::RefTracker::created(::jace::RefTracker::kind, ref, site)
+	#define JACE_REF_DELETED(kind, ref) ::jace::RefTracker::deleted(::jace::RefTracker::kind, ref)
+#else
+	#define JACE_REF_CREATED(kind, ref, site) ((void) 0)
+	#define JACE_REF_DELETED(kind, ref) ((void) 0)
+#endif
+
+#endif // #ifndef JACE_REF_TRACKER_H
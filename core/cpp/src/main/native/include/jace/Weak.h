@@ -0,0 +1,130 @@
+#ifndef JACE_WEAK_H
+#define JACE_WEAK_H
+
+#include "jace/Namespace.h"
+#include "jace/Jace.h"
+#include "jace/proxy/JObject.h"
+
+#include <jni.h>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A weak reference to a java object, which does not keep the object from being garbage collected.
+ *
+ * For example:
+ *
+ *   Weak<Config> weak(config);
+ *   ...
+ *   Config config = weak.lock();
+ *   if (!config.isNull())
+ *     config.reload();
+ *
+ * @see WeakCache
+ */
+template <class T> class Weak
+{
+public:
+	/**
+	 * Creates a null weak reference.
+	 */
+	Weak(): mRef(0)
+	{}
+
+	/**
+	 * Creates a weak reference to the object of a proxy.
+	 *
+	 * @throws JNIException if the weak reference can not be allocated.
+	 */
+	explicit Weak(const T& object): mRef(newWeakGlobalRef(attach(), static_cast<jobject>(object)))
+	{}
+
+	/**
+	 * Creates a weak reference to the same object as another, or a null weak reference
+	 * if the object has been garbage collected.
+	 */
+	Weak(const Weak& other): mRef(other.mRef ? newWeakGlobalRef(attach(), other.mRef) : 0)
+	{}
+
+	/**
+	 * Deletes the weak reference.
+	 */
+	~Weak() throw ()
+	{
+		if (mRef)
+			deleteWeakGlobalRef(mRef);
+	}
+
+	/**
+	 * Refers to the same object as another, or to nothing if the object has been garbage collected.
+	 */
+	Weak& operator=(const Weak& other)
+	{
+		if (this != &other)
+		{
+			jobject ref = other.mRef ? newWeakGlobalRef(attach(), other.mRef) : 0;
+			if (mRef)
+				deleteWeakGlobalRef(mRef);
+			mRef = ref;
+		}
+		return *this;
+	}
+
+	/**
+	 * Returns a proxy holding a strong reference to the object, or a null proxy if the
+	 * object has been garbage collected. The object cannot be collected while the proxy lives.
+	 */
+	T lock() const
+	{
+		return lock(attach());
+	}
+
+	/**
+	 * Returns a proxy holding a strong reference to the object, or a null proxy if the
+	 * object has been garbage collected.
+	 */
+	T lock(JNIEnv* env) const
+	{
+		// NewLocalRef() returns null once the object has been collected
+		jobject local = mRef ? env->NewLocalRef(mRef) : 0;
+		T result(local);
+		if (local)
+			env->DeleteLocalRef(local);
+		return result;
+	}
+
+	/**
+	 * Returns true if the object has been garbage collected, or the reference is null.
+	 *
+	 * The object may be collected at any time, so a false result does not mean that lock()
+	 * will succeed.
+	 */
+	bool expired() const
+	{
+		return expired(attach());
+	}
+
+	/**
+	 * Returns true if the object has been garbage collected, or the reference is null.
+	 */
+	bool expired(JNIEnv* env) const
+	{
+		return !mRef || env->IsSameObject(mRef, 0) == JNI_TRUE;
+	}
+
+	/**
+	 * Returns true if this weak reference refers to the object of a proxy.
+	 */
+	bool refersTo(JNIEnv* env, const ::jace::proxy::JObject& object) const
+	{
+		return mRef && !object.isNull() && env->IsSameObject(mRef, static_cast<jobject>(object)) == JNI_TRUE;
+	}
+
+private:
+	jobject mRef;
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_WEAK_H
@@ -0,0 +1,224 @@
+#ifndef JACE_WEAK_CACHE_H
+#define JACE_WEAK_CACHE_H
+
+#include "jace/Namespace.h"
+#include "jace/Jace.h"
+#include "jace/Weak.h"
+#include "jace/proxy/JObject.h"
+
+#include <jni.h>
+
+#include <algorithm>
+#include <map>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+BEGIN_NAMESPACE(jace)
+
+
+/**
+ * A map from java objects to C++ values, which does not keep its keys from being garbage collected.
+ *
+ * Keys are compared by identity, as in java.util.IdentityHashMap. Once a key is collected its
+ * entry can no longer be found, and it is removed, along with its value, the next time the
+ * cache is purged. The cache purges itself as it grows, and purge() may also be called directly.
+ *
+ * For example:
+ *
+ *   WeakCache<Config, ParsedConfig> cache;
+ *
+ *   ParsedConfig parsed;
+ *   if (!cache.find(config, parsed))
+ *   {
+ *     parsed = parse(config);
+ *     cache.put(config, parsed);
+ *   }
+ *
+ * WeakCache is thread-safe.
+ */
+template <class Key, class Value> class WeakCache: public boost::noncopyable
+{
+public:
+	/**
+	 * Creates an empty cache.
+	 */
+	WeakCache(): mPurgeThreshold(minimumPurgeThreshold)
+	{}
+
+	/**
+	 * Looks up the value of a key.
+	 *
+	 * @return false if the cache has no value for the key
+	 */
+	bool find(const Key& key, Value& value) const
+	{
+		JNIEnv* env = attach();
+		jint hash = identityHashCode(env, static_cast<jobject>(key));
+
+		boost::mutex::scoped_lock lock(mMutex);
+		typename Entries::const_iterator it = findEntry(env, hash, key);
+		if (it == mEntries.end())
+			return false;
+		value = it->second.value;
+		return true;
+	}
+
+	/**
+	 * Returns true if the cache has a value for the key.
+	 */
+	bool contains(const Key& key) const
+	{
+		JNIEnv* env = attach();
+		jint hash = identityHashCode(env, static_cast<jobject>(key));
+
+		boost::mutex::scoped_lock lock(mMutex);
+		return findEntry(env, hash, key) != mEntries.end();
+	}
+
+	/**
+	 * Sets the value of a key, replacing its previous value if any.
+	 *
+	 * @throws JNIException if the key is null.
+	 */
+	void put(const Key& key, const Value& value)
+	{
+		if (key.isNull())
+			throw JNIException("[WeakCache::put] Can not cache a null key.");
+
+		JNIEnv* env = attach();
+		jint hash = identityHashCode(env, static_cast<jobject>(key));
+
+		boost::mutex::scoped_lock lock(mMutex);
+		typename Entries::iterator it = findEntry(env, hash, key);
+		if (it != mEntries.end())
+		{
+			it->second.value = value;
+			return;
+		}
+
+		Entry entry;
+		entry.key = boost::shared_ptr< Weak<Key> >(new Weak<Key>(key));
+		entry.value = value;
+		mEntries.insert(std::make_pair(hash, entry));
+
+		if (mEntries.size() >= mPurgeThreshold)
+		{
+			purgeLocked(env);
+			mPurgeThreshold = std::max(static_cast<size_t>(minimumPurgeThreshold), 2 * mEntries.size());
+		}
+	}
+
+	/**
+	 * Removes the value of a key.
+	 *
+	 * @return false if the cache had no value for the key
+	 */
+	bool erase(const Key& key)
+	{
+		JNIEnv* env = attach();
+		jint hash = identityHashCode(env, static_cast<jobject>(key));
+
+		boost::mutex::scoped_lock lock(mMutex);
+		typename Entries::iterator it = findEntry(env, hash, key);
+		if (it == mEntries.end())
+			return false;
+		mEntries.erase(it);
+		return true;
+	}
+
+	/**
+	 * Removes the entries whose keys have been garbage collected.
+	 *
+	 * @return the number of entries removed
+	 */
+	size_t purge()
+	{
+		JNIEnv* env = attach();
+		boost::mutex::scoped_lock lock(mMutex);
+		return purgeLocked(env);
+	}
+
+	/**
+	 * Removes every entry.
+	 */
+	void clear()
+	{
+		boost::mutex::scoped_lock lock(mMutex);
+		mEntries.clear();
+		mPurgeThreshold = minimumPurgeThreshold;
+	}
+
+	/**
+	 * Returns the number of entries, including those whose keys have been garbage
+	 * collected but which have not been purged yet.
+	 */
+	size_t size() const
+	{
+		boost::mutex::scoped_lock lock(mMutex);
+		return mEntries.size();
+	}
+
+private:
+	struct Entry
+	{
+		// Shared, so that copying an entry does not create a new weak reference
+		boost::shared_ptr< Weak<Key> > key;
+		Value value;
+	};
+
+	/**
+	 * The entries, by the identity hash code of their key.
+	 */
+	typedef std::multimap<jint, Entry> Entries;
+
+	enum { minimumPurgeThreshold = 16 };
+
+	typename Entries::iterator findEntry(JNIEnv* env, jint hash, const Key& key)
+	{
+		std::pair<typename Entries::iterator, typename Entries::iterator> range = mEntries.equal_range(hash);
+		for (typename Entries::iterator it = range.first; it != range.second; ++it)
+		{
+			if (it->second.key->refersTo(env, key))
+				return it;
+		}
+		return mEntries.end();
+	}
+
+	typename Entries::const_iterator findEntry(JNIEnv* env, jint hash, const Key& key) const
+	{
+		std::pair<typename Entries::const_iterator, typename Entries::const_iterator> range =
+			mEntries.equal_range(hash);
+		for (typename Entries::const_iterator it = range.first; it != range.second; ++it)
+		{
+			if (it->second.key->refersTo(env, key))
+				return it;
+		}
+		return mEntries.end();
+	}
+
+	size_t purgeLocked(JNIEnv* env)
+	{
+		size_t count = 0;
+		for (typename Entries::iterator it = mEntries.begin(); it != mEntries.end();)
+		{
+			if (it->second.key->expired(env))
+			{
+				mEntries.erase(it++);
+				++count;
+			}
+			else
+				++it;
+		}
+		return count;
+	}
+
+	mutable boost::mutex mMutex;
+	Entries mEntries;
+	size_t mPurgeThreshold;
+};
+
+END_NAMESPACE(jace)
+
+#endif // #ifndef JACE_WEAK_CACHE_H
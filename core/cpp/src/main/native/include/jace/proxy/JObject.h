@@ -5,6 +5,9 @@
 #include "jace/JArguments.h"
 #include "jace/proxy/JValue.h"
 
+#include <string>
+
+#include <boost/config.hpp>
 
 BEGIN_NAMESPACE_2(jace, proxy)
 
@@ -46,6 +49,10 @@ BEGIN_NAMESPACE_2(jace, proxy)
  * and does not release that global reference until it's lifetime
  * has ended.
  *
+ * Copies of a JObject share its global reference, through an atomic
+ * reference count, so that copying a proxy makes no JNI call. The
+ * global reference is deleted along with the last copy.
+ *
  * @author Toby Reyelts
  */
 class JObject: public ::jace::proxy::JValue
@@ -70,7 +77,7 @@ public:
 	explicit JObject(jobject object);
 
 	/**
-	 * Creates a new reference to an existing object.
+	 * Creates a new reference to an existing object, which shares its global reference.
 	 *
 	 * @param object the object
 	 */
@@ -82,10 +89,24 @@ public:
 	virtual ~JObject() throw();
 
 	/**
-	 * Sets the reference to another object.
+	 * Sets the reference to another object, sharing its global reference.
 	 */
 	JObject& operator=(const JObject& other);
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+	/**
+	 * Takes over the reference of another object, which becomes a null reference.
+	 *
+	 * Unlike copying, this does not create a new global reference.
+	 */
+	JObject(JObject&& object);
+
+	/**
+	 * Takes over the reference of another object, which becomes a null reference.
+	 */
+	JObject& operator=(JObject&& other);
+#endif
+
 	/**
 	 * Returns the underlying JNI jobject for this JObject.
 	 *
@@ -151,6 +172,32 @@ protected:
 	 */
 	void setJavaJniObject(jobject object);
 
+	/**
+	 * Takes over the global reference of another object, which becomes a null reference,
+	 * and releases the reference this object held.
+	 *
+	 * Used by move constructors and move assignment operators, including those of
+	 * generated proxies.
+	 */
+	void moveJavaJniObject(JObject& other);
+
+	/**
+	 * Shares the global reference of another object, and releases the reference this object held.
+	 *
+	 * Used by copy constructors and copy assignment operators, including those of
+	 * generated proxies. If other does not own its reference, as is the case of a
+	 * jace::Local, a new global reference is created instead.
+	 */
+	void shareJavaJniObject(const JObject& other);
+
+	/**
+	 * Sets the jobject for this JObject, without creating a global reference.
+	 *
+	 * The JObject does not own the reference: it must be reset to null before
+	 * the JObject is destroyed. Used by jace::Local.
+	 */
+	void borrowJavaJniObject(jobject object);
+
 	/**
 	 * Constructs a new instance of the given class
 	 * with the given arguments.
@@ -162,6 +209,24 @@ protected:
 	 *   is thrown during method execution.
 	 */
 	static jobject newObject(const ::jace::JClass& jClass, const ::jace::JArguments& arguments);
+
+private:
+	/**
+	 * A global reference, and the number of JObjects sharing it.
+	 */
+	class SharedRef;
+
+	/**
+	 * Releases the reference of this object, deleting the global reference if
+	 * no other object shares it, and resets this object to null.
+	 */
+	void release();
+
+	/**
+	 * The global reference owned by this object, or null if it is a null reference,
+	 * or borrows its reference.
+	 */
+	SharedRef* mShared;
 };
 
 
@@ -0,0 +1,146 @@
+#ifndef JACE_RUNTIME_BULKINVOKER_H
+#define JACE_RUNTIME_BULKINVOKER_H
+
+#include "jace/Namespace.h"
+#include "jace/JClass.h"
+#include "jace/proxy/JValue.h"
+#include "jace/proxy/JObject.h"
+
+#include <string>
+#include <vector>
+#include <jni.h>
+
+BEGIN_NAMESPACE_2(jace, runtime)
+
+/**
+ * Packs many java method calls into one batch, and executes the whole batch with
+ * a single call into org.jace.util.BulkInvoker.
+ *
+ * For example:
+ *
+ *   static BulkInvoker::Target add(List::staticGetJavaJniClass(), "add", "(Ljava/lang/Object;)Z");
+ *
+ *   BulkInvoker batch;
+ *   for (size_t i = 0; i < items.size(); ++i)
+ *     batch.add(add) << list << items[i];
+ *   batch.execute();
+ *
+ *   bool added = batch.getResult(0).z;
+ *
+ * Arguments are only read by execute(), so they must stay alive until then.
+ */
+class BulkInvoker
+{
+public:
+	/**
+	 * The kinds of method a Target may refer to.
+	 */
+	enum Kind { Virtual = 0, Static = 1, Constructor = 2 };
+
+	/**
+	 * A java method that has been bound for use in batches.
+	 *
+	 * Binding a method is expensive, Targets are meant to be created once and reused.
+	 */
+	class Target
+	{
+	public:
+		/**
+		 * Binds the method with the given name and JNI descriptor.
+		 *
+		 * For constructors, the name is ignored and the descriptor returns void, as in "(I)V".
+		 *
+		 * @throws JNIException if the method cannot be bound.
+		 */
+		Target(const ::jace::JClass& jClass, const std::string& name, const std::string& descriptor,
+			Kind kind = Virtual);
+
+	private:
+		friend class BulkInvoker;
+
+		jlong mIndex;
+		// The JNI type letter of each parameter, including the receiver of virtual methods, and of the result
+		std::string mParameters;
+		char mResult;
+	};
+
+	/**
+	 * Creates an empty batch.
+	 */
+	BulkInvoker();
+
+	/**
+	 * Releases the results of the batch.
+	 */
+	~BulkInvoker();
+
+	/**
+	 * Adds a call to the batch. Its arguments must follow, using operator<<.
+	 *
+	 * @return *this
+	 * @throws JNIException if the previous call is missing arguments.
+	 */
+	BulkInvoker& add(const Target& target);
+
+	/**
+	 * Adds an argument to the last call of the batch.
+	 *
+	 * @throws JNIException if the call already has all of its arguments.
+	 */
+	BulkInvoker& operator<<(const ::jace::proxy::JValue& argument);
+
+	/**
+	 * Returns the number of calls in the batch.
+	 */
+	size_t size() const;
+
+	/**
+	 * Executes every call of the batch, in order, with a single JNI call.
+	 *
+	 * @throws JNIException if a call is missing arguments.
+	 * @throws a matching C++ proxy, if a java exception is thrown by a call. The batch
+	 *   stops at that call. The primitive results of the calls before it remain available
+	 *   through getResult(), but no object result is.
+	 */
+	void execute();
+
+	/**
+	 * Returns the result of the given call, for methods returning a primitive type.
+	 */
+	jvalue getResult(size_t call) const;
+
+	/**
+	 * Returns the result of the given call, for methods returning an object and for constructors.
+	 */
+	::jace::proxy::JObject getObjectResult(size_t call) const;
+
+	/**
+	 * Removes all calls and results, so that the BulkInvoker can be reused.
+	 */
+	void clear();
+
+private:
+	/**
+	 * Prevent copying.
+	 */
+	BulkInvoker(const BulkInvoker&);
+	BulkInvoker& operator=(const BulkInvoker&);
+
+	struct Call
+	{
+		const Target* target;
+		size_t slot;
+	};
+
+	void checkComplete() const;
+
+	std::vector<jlong> mSlots;
+	std::vector<jobject> mObjects;
+	std::vector<Call> mCalls;
+	size_t mPendingArguments;
+	jobjectArray mResults;
+};
+
+END_NAMESPACE_2(jace, runtime)
+
+#endif // #ifndef JACE_RUNTIME_BULKINVOKER_H
@@ -0,0 +1,46 @@
+#ifndef JACE_RUNTIME_NATIVEEXECUTOR_H
+#define JACE_RUNTIME_NATIVEEXECUTOR_H
+
+#include "jace/Namespace.h"
+#include "jace/JvmExecutor.h"
+#include "jace/proxy/JObject.h"
+
+BEGIN_NAMESPACE_2(jace, runtime)
+
+/**
+ * Returns a java.util.concurrent.Executor that runs its Runnables on the workers of a JvmExecutor.
+ *
+ * This lets java libraries share the threads of the process, instead of starting their own.
+ * For example:
+ *
+ *   JvmExecutor pool(4);
+ *   CompletableFuture::supplyAsync(supplier, java_cast<Executor>(createExecutor(pool)));
+ *
+ * A Runnable that throws is reported to the uncaught exception handler of the worker, as it
+ * would be on a java thread. Once the JvmExecutor is at capacity, or has been shut down,
+ * execute() throws a RejectedExecutionException.
+ *
+ * The JvmExecutor must outlive the proxy: java code must no longer call it once the
+ * JvmExecutor is destroyed.
+ *
+ * @throws JNIException if the proxy cannot be created
+ */
+::jace::proxy::JObject createExecutor(::jace::JvmExecutor& executor);
+
+/**
+ * Returns a java.util.concurrent.ExecutorService that runs its tasks on the workers of a JvmExecutor.
+ *
+ * The service is an org.jace.util.NativeExecutorService wrapping createExecutor(executor).
+ * Shutting it down from java does not shut the JvmExecutor down, which remains owned by native code.
+ *
+ * A task the JvmExecutor drops without running, as the virtual machine is shutting down or out
+ * of memory, is never recorded as done: the service then never terminates, and awaitTermination()
+ * runs until its timeout.
+ *
+ * @throws JNIException if the service cannot be created
+ */
+::jace::proxy::JObject createExecutorService(::jace::JvmExecutor& executor);
+
+END_NAMESPACE_2(jace, runtime)
+
+#endif // #ifndef JACE_RUNTIME_NATIVEEXECUTOR_H
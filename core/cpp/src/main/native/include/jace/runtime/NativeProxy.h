@@ -40,15 +40,26 @@ typedef ::jace::JArray< ::jace::proxy::JObject> CallbackArgs;
 class Callback { 
 public:
     typedef boost::function< jobject (JACE_NATIVE_CALLBACK_ARGS) > Fx;
+
+    /**
+     * A callback that also receives the JNIEnv of the calling thread, so it can pass it
+     * to the JNIEnv overloads of JMethod, JField, JArray and generated proxies instead of
+     * attaching again for every nested call.
+     */
+    typedef boost::function< jobject (JNIEnv*, JACE_NATIVE_CALLBACK_ARGS) > EnvFx;
     
-    Callback(const Fx& fx) : m_fx(fx) {}
-    template <typename R> Callback(R(*fx)(JACE_NATIVE_CALLBACK_ARGS)) : m_fx(fx) {}
+    Callback(const Fx& fx) : m_fx(boost::bind(fx, _2, _3)) {}
+    template <typename R> Callback(R(*fx)(JACE_NATIVE_CALLBACK_ARGS)) : m_fx(boost::bind(fx, _2, _3)) {}
+    template <typename R> Callback(R(*fx)(JNIEnv*, JACE_NATIVE_CALLBACK_ARGS)) : m_fx(fx) {}
+
+    /** Creates a callback from a function object that receives the JNIEnv. */
+    static Callback withEnv(const EnvFx& fx) { return Callback(fx, 0); }
     
     /* void (and JVoid) functions */
 
     /* Functions that return native types */
     #define _JACE_CONSTRUCTOR(t, f)                                             \
-    Callback(t(*fx)(JACE_NATIVE_CALLBACK_ARGS)) : m_fx(boost::bind(f, fx, _1, _2)) {}
+    Callback(t(*fx)(JACE_NATIVE_CALLBACK_ARGS)) : m_fx(boost::bind(f, fx, _2, _3)) {}
 
     /* Void types */
     _JACE_CONSTRUCTOR(void, wrapVoid)
@@ -72,8 +83,8 @@ public:
     #undef _JACE_TYPE_CONSTRUCTOR
     #undef _JACE_CONSTRUCTOR
     
-    jobject operator()(JNIEnv*, jclass, jobject obj, jobjectArray args) const { 
-        return m_fx(::jace::proxy::JObject(obj), CallbackArgs(args));
+    jobject operator()(JNIEnv* env, jclass, jobject obj, jobjectArray args) const { 
+        return m_fx(env, ::jace::proxy::JObject(obj), CallbackArgs(args));
     }
 
     /* Copy and default constructor and assignment */
@@ -81,6 +92,8 @@ public:
     Callback& operator=(const Callback& rhs) { m_fx = rhs.m_fx; return *this; }
     
 private:
+    Callback(const EnvFx& fx, int) : m_fx(fx) {}
+
     static jobject wrapVoid(const boost::function<void (JACE_NATIVE_CALLBACK_ARGS)>& fx, 
                                            JACE_NATIVE_CALLBACK_ARGS) {
         try {
@@ -109,9 +122,17 @@ private:
     }
         
 private:
-    Fx  m_fx;
+    EnvFx  m_fx;
 };
 
+/**
+ * Returns the context of the proxy whose callback is running on the current thread,
+ * or 0 if the proxy was built without one.
+ *
+ * @see Builder::build(jlong)
+ */
+jlong getContext();
+
 class Builder : public boost::noncopyable {
 public:
     Builder(const std::string& className);
@@ -125,16 +146,31 @@ public:
         std::string msg = "Proxy not instance of " + T::staticGetJavaJniClass().getInternalName();
         throw JNIException(msg);
     }
+
+    /**
+     * Builds a proxy whose callbacks can retrieve the given context through getContext().
+     * This lets a single Builder serve many proxies, each with its own native state.
+     */
+    template <typename T> T build(jlong context) {
+        ::jace::proxy::JObject obj = instantiate(context);
+        if (::jace::instanceof<T>(obj)) {
+            return ::jace::java_cast<T>(obj);
+        }
+        std::string msg = "Proxy not instance of " + T::staticGetJavaJniClass().getInternalName();
+        throw JNIException(msg);
+    }
     const Callback& get(int idx) const { return m_callbacks[idx]; }
     
 private:
     ::jace::proxy::JObject instantiate();
+    ::jace::proxy::JObject instantiate(jlong context);
     
     /* Member variables */
     jclass                  m_classRef;
     jobject                 m_instance;
     jmethodID               m_registerCallbackMethod;
     jmethodID               m_createProxyMethod;
+    jmethodID               m_createProxyWithContextMethod;
     
     std::vector<Callback>   m_callbacks;
 };
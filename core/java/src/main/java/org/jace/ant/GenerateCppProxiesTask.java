@@ -73,6 +73,10 @@ public class GenerateCppProxiesTask extends Task
 	 * default is true.
 	 */
 	private boolean minimizeDependencies = true;
+	/**
+	 * Indicates whether methods should get an overload returning java exceptions in a JResult.
+	 */
+	private boolean exceptionsAsValues;
 
 	/**
 	 * Sets the directory containing the input header files.
@@ -149,6 +153,17 @@ public class GenerateCppProxiesTask extends Task
 		this.minimizeDependencies = minimizeDependencies;
 	}
 
+	/**
+	 * Indicates whether methods should get an overload taking {@code jace::nothrow}, which returns
+	 * java exceptions in a {@code jace::JResult} instead of throwing them.
+	 *
+	 * @param exceptionsAsValues true if the overloads should be generated. The default is false.
+	 */
+	public void setExceptionsAsValues(boolean exceptionsAsValues)
+	{
+		this.exceptionsAsValues = exceptionsAsValues;
+	}
+
 	/**
 	 * Sets the Java classpath.
 	 *
@@ -179,7 +194,7 @@ public class GenerateCppProxiesTask extends Task
 			extraDependencies.add(TypeNameFactory.fromIdentifier(dependency.getName()));
 		AutoProxy.Builder autoProxy = new AutoProxy.Builder(inputHeaders, inputSources, outputHeaders,
 			outputSources, new ClassPath(classpath.toString())).accessibility(accessibility).
-			minimizeDependencies(minimizeDependencies);
+			minimizeDependencies(minimizeDependencies).exceptionsAsValues(exceptionsAsValues);
 		for (TypeName dependency: extraDependencies)
 			autoProxy.extraDependency(dependency);
 		try
@@ -252,6 +267,7 @@ public class GenerateCppProxiesTask extends Task
 		return getClass().getSimpleName() + "[inputHeaders=" + inputHeaders + ", inputSources="
 					 + inputSources + ", outputHeader=" + outputHeaders + ", outputSources=" + outputSources
 					 + ", minimizeDependencies=" + minimizeDependencies
+					 + ", exceptionsAsValues=" + exceptionsAsValues
 					 + "]";
 	}
 }
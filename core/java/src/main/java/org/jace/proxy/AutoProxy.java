@@ -51,6 +51,7 @@ public class AutoProxy
 	private final File outputSources;
 	private final ClassPath classPath;
 	private final AccessibilityType accessibility;
+	private final boolean exceptionsAsValues;
 	/**
 	 * The set of classes to process.
 	 */
@@ -73,6 +74,7 @@ public class AutoProxy
 		this.outputSources = builder.outputSources;
 		this.classPath = builder.classPath;
 		this.accessibility = builder.accessibility;
+		this.exceptionsAsValues = builder.exceptionsAsValues;
 		this.proxies = new ClassSet(builder.classPath, builder.minimizeDependencies);
 		if (builder.minimizeDependencies)
 			proxies.addClasses(builder.extraDependencies);
@@ -188,7 +190,7 @@ public class AutoProxy
 					getAbsolutePath());
 			}
 			new ProxyGenerator.Builder(classPath, classFile, dependencies).accessibility(accessibility).
-				build().writeProxy(outputHeaders, outputSources);
+				exceptionsAsValues(exceptionsAsValues).build().writeProxy(outputHeaders, outputSources);
 			input.close();
 		}
 	}
@@ -343,7 +345,9 @@ public class AutoProxy
 					 + "  -protected : Generate public, protected fields and methods." + newLine
 					 + "  -package : Generate public, protected, package-private fields and methods."
 					 + newLine
-					 + "  -private : Generate public, protected, package-private, private fields and methods.";
+					 + "  -private : Generate public, protected, package-private, private fields and methods."
+					 + newLine
+					 + "  -nothrow : Also generate overloads of methods that return java exceptions in a JResult.";
 	}
 
 	/**
@@ -364,7 +368,7 @@ public class AutoProxy
 	@SuppressWarnings("UseOfSystemOutOrSystemErr")
 	public static void main(String[] args)
 	{
-		if (args.length < 5 || args.length > 7)
+		if (args.length < 5 || args.length > 8)
 		{
 			System.out.println(getUsage());
 			return;
@@ -384,6 +388,7 @@ public class AutoProxy
 		boolean minimizeDependencies = false;
 		Set<TypeName> extraDependencies = Sets.newHashSetWithExpectedSize(args.length - 5);
 		AccessibilityType accessibility = AccessibilityType.PUBLIC;
+		boolean exceptionsAsValues = false;
 		for (int i = 5; i < args.length; ++i)
 		{
 			String option = args[i];
@@ -405,6 +410,8 @@ public class AutoProxy
 				accessibility = AccessibilityType.PACKAGE;
 			else if (option.equals("-private"))
 				accessibility = AccessibilityType.PRIVATE;
+			else if (option.equals("-nothrow"))
+				exceptionsAsValues = true;
 			else
 			{
 				System.out.println("Not an understood option: [" + option + "]");
@@ -416,7 +423,8 @@ public class AutoProxy
 
 		AutoProxy.Builder autoProxy = new AutoProxy.Builder(inputHeaders, inputSources, outputHeaders,
 			outputSources,
-			new ClassPath(classPath)).accessibility(accessibility).minimizeDependencies(minimizeDependencies);
+			new ClassPath(classPath)).accessibility(accessibility).minimizeDependencies(minimizeDependencies).
+			exceptionsAsValues(exceptionsAsValues);
 		for (TypeName dependency: extraDependencies)
 			autoProxy.extraDependency(dependency);
 		Logger log = LoggerFactory.getLogger(AutoProxy.class);
@@ -449,6 +457,7 @@ public class AutoProxy
 		private final ClassPath classPath;
 		private AccessibilityType accessibility = AccessibilityType.PUBLIC;
 		private boolean minimizeDependencies = true;
+		private boolean exceptionsAsValues;
 		private final Set<TypeName> extraDependencies = Sets.newHashSet();
 
 		/**
@@ -536,6 +545,20 @@ public class AutoProxy
 			return this;
 		}
 
+		/**
+		 * Indicates whether methods should get an overload taking <code>jace::nothrow</code>, which returns
+		 * java exceptions in a <code>jace::JResult</code> instead of throwing them.
+		 *
+		 * @param value
+		 *        <code>true</code> if the overloads should be generated. The default is false.
+		 * @return the Builder
+		 */
+		public Builder exceptionsAsValues(boolean value)
+		{
+			this.exceptionsAsValues = value;
+			return this;
+		}
+
 		/**
 		 * Specifies classes that should be exported in spite of the fact that they are not referenced by input files.
 		 * This is mechanism is only enabled when <code>minimizeDependencies</code> is <code>true</code>.
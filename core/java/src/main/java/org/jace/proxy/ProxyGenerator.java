@@ -69,9 +69,14 @@ public class ProxyGenerator
 		PRIVATE
 	}
 	private final static String newLine = System.getProperty("line.separator");
+	/**
+	 * The maximum number of arguments that JMethod::invoke() accepts without a JArguments.
+	 */
+	private final static int maxInlineArguments = 10;
 	private final ClassFile classFile;
 	private final ClassPath classPath;
 	private final AccessibilityType accessibility;
+	private final boolean exceptionsAsValues;
 	private final MetaClassFilter dependencyFilter;
 	private final Logger log = LoggerFactory.getLogger(ProxyGenerator.class);
 	/**
@@ -92,6 +97,7 @@ public class ProxyGenerator
 		assert (builder != null);
 		this.classFile = builder.classFile;
 		this.accessibility = builder.accessibility;
+		this.exceptionsAsValues = builder.exceptionsAsValues;
 		this.dependencyFilter = builder.dependencyFilter;
 		this.classPath = builder.classPath;
 	}
@@ -155,6 +161,7 @@ public class ProxyGenerator
 		Util.generateComment(output, "Standard Jace headers needed to implement this class.");
 
 		output.write("#include \"jace/JArguments.h\"" + newLine);
+		output.write("#include \"jace/JConstructor.h\"" + newLine);
 		output.write("#include \"jace/JMethod.h\"" + newLine);
 		output.write("#include \"jace/JField.h\"" + newLine);
 		output.write("#include \"jace/JClassImpl.h\"" + newLine);
@@ -163,6 +170,7 @@ public class ProxyGenerator
 			output.write("#include \"jace/proxy/java/lang/Integer.h\"" + newLine);
 
 		output.write("#include <boost/thread/mutex.hpp>" + newLine);
+		output.write("#include <boost/thread/once.hpp>" + newLine);
 	}
 
 	/**
@@ -296,20 +304,20 @@ public class ProxyGenerator
 			MethodAccessFlagSet accessFlagSet = method.getAccessFlags();
 
 			// If this is a constructor, there is no return-type
+			String methodHead;
 			if (isConstructor)
-				output.write(className + " " + className + "::Factory::create");
+				methodHead = className + " " + className + "::Factory::create";
 			else
 			{
 				// handle clashes between C++ keywords and java identifiers
 				methodName = CKeyword.adjust(methodName);
 
 				if (returnType.getSimpleName().equals("JVoid"))
-					output.write("void");
+					methodHead = "void";
 				else
-					output.write("::" + returnType.getFullyQualifiedName("::"));
-				output.write(" " + className + "::" + methodName);
+					methodHead = "::" + returnType.getFullyQualifiedName("::");
+				methodHead += " " + className + "::" + methodName;
 			}
-			output.write("(");
 
 			List<TypeName> parameterTypes = method.getParameterTypes();
 			DelimitedCollection<TypeName> parameterList = new DelimitedCollection<>(parameterTypes);
@@ -326,41 +334,69 @@ public class ProxyGenerator
 					return result;
 				}
 			};
-			output.write(parameterList.toString(sf, ", ") + ")");
+			String parameters = parameterList.toString(sf, ", ");
 
 			// If this is a constructor, we need to handle it differently from other methods
 			if (isConstructor)
 			{
+				output.write(methodHead + "(" + parameters + ")");
 				output.write("{" + newLine);
 
-				// initialize any arguments we have
-				output.write("  JArguments arguments;" + newLine);
+				boolean useArgumentList = parameterTypes.size() > maxInlineArguments;
 
-				if (parameterTypes.size() > 0)
+				// initialize any arguments we have
+				if (useArgumentList)
 				{
+					output.write("  JArguments arguments;" + newLine);
 					output.write("  arguments");
 					for (int i = 0; i < parameterTypes.size(); ++i)
 						output.write(" << p" + i);
 					output.write(";" + newLine);
 				}
 
-				// set the jni object for this c++ object to the result of the call to newObject
-				output.write("  jobject localRef = newObject(" + className
-										 + "::staticGetJavaJniClass(), arguments);" + newLine);
+				// Every call shares one JConstructor, so the constructor is only looked up once
+				generateSharedMember(output, "JConstructor", "constructor", className + "::staticGetJavaJniClass(), \""
+														 + method.getDescriptor() + "\"");
+
+				// set the jni object for this c++ object to the result of the constructor call
+				output.write("  jobject localRef = constructor->invoke(");
+				if (useArgumentList)
+					output.write("arguments");
+				else
+				{
+					for (int i = 0; i < parameterTypes.size(); ++i)
+					{
+						if (i > 0)
+							output.write(", ");
+						output.write("p" + i);
+					}
+				}
+				output.write(");" + newLine);
 				output.write("  " + className + " result = " + className + "(localRef);" + newLine);
 				output.write("  deleteLocalRef(localRef), localRef = 0;" + newLine);
 				output.write("  return result;" + newLine);
 			}
 			else
 			{
-				output.write(newLine);
+				// The method body takes the JNIEnv of the caller, tagged with with_env_t so that calls passing a
+				// literal 0 never select it. The overload without one attaches.
+				generateAttachingMethodDefinition(output, methodHead, methodName, returnType, parameters,
+					parameterTypes.size());
+
+				output.write(methodHead + "(::jace::with_env_t, JNIEnv* env");
+				if (!parameters.isEmpty())
+					output.write(", " + parameters);
+				output.write(")" + newLine);
 				output.write("{" + newLine);
 
-				// Initialize any arguments we have
-				output.write("  JArguments arguments;" + newLine);
+				// Methods with few enough parameters pass them to JMethod directly, which marshals them on the stack.
+				// Only longer parameter lists go through JArguments.
+				boolean useArgumentList = parameterTypes.size() > maxInlineArguments;
 
-				if (parameterTypes.size() > 0)
+				// Initialize any arguments we have
+				if (useArgumentList)
 				{
+					output.write("  JArguments arguments;" + newLine);
 					output.write("  arguments");
 					for (int i = 0; i < parameterTypes.size(); ++i)
 					{
@@ -369,26 +405,40 @@ public class ProxyGenerator
 					output.write(";" + newLine);
 				}
 
+				// Every call shares one JMethod, so the jmethodID is only looked up once. The method is bound to
+				// the declaring class so that the cached id is valid for instances of any subclass, and is given
+				// the descriptor from the class file so that its signature never has to be computed at runtime.
+				generateSharedMember(output, "JMethod< ::" + returnType.getFullyQualifiedName("::") + " >", "method",
+														 className + "::staticGetJavaJniClass(), \"" + method.getName() + "\", \""
+														 + method.getDescriptor() + "\"");
+
 				// If this is a non-void method call we need to return the result of the method call
 				output.write("  ");
 
 				if (!returnType.getSimpleName().equals("JVoid"))
 					output.write("return ");
 
-				output.write("JMethod< ");
-				output.write("::" + returnType.getFullyQualifiedName("::"));
-				output.write(" >");
-				output.write("(\"" + method.getName() + "\").invoke(");
+				output.write("method->invoke(env, ");
 
 				// If this method is static, we need to provide the class info, otherwise we provide a reference to itself.
 				if (method.getAccessFlags().contains(MethodAccessFlag.STATIC))
 					output.write("staticGetJavaJniClass()");
 				else
 					output.write("*this");
-				output.write(", arguments);" + newLine);
+				if (useArgumentList)
+					output.write(", arguments");
+				else
+				{
+					for (int i = 0; i < parameterTypes.size(); ++i)
+						output.write(", p" + i);
+				}
+				output.write(");" + newLine);
 			}
 			output.write("}" + newLine);
 			output.write(newLine);
+
+			if (exceptionsAsValues && !isConstructor)
+				generateNothrowMethodDefinition(output, className, methodName, method, returnType, parameters);
 		}
 
 		Util.generateComment(output, "Creates a new null reference." + newLine + newLine
@@ -412,14 +462,43 @@ public class ProxyGenerator
 		output.write("}" + newLine);
 		output.write(newLine);
 
+		// Copies share the global reference of the original
 		output.write(className + "::" + className + "(const " + className + "& object) "
 								 + getInitializerName()
 								 + newLine);
 		output.write("{" + newLine);
-		output.write("  setJavaJniObject(object);" + newLine);
+		output.write("  shareJavaJniObject(object);" + newLine);
 		output.write("}" + newLine);
 		output.write(newLine);
 
+		// Moving a proxy takes over its global reference, instead of creating a new one
+		output.write("#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES" + newLine);
+		output.write(className + "::" + className + "(" + className + "&& object) " + getInitializerName()
+								 + newLine);
+		output.write("{" + newLine);
+		output.write("  moveJavaJniObject(object);" + newLine);
+		output.write("}" + newLine);
+		output.write(newLine);
+
+		output.write(className + "& " + className + "::operator=(" + className + "&& object)" + newLine);
+		output.write("{" + newLine);
+		output.write("  moveJavaJniObject(object);" + newLine);
+		output.write("  return *this;" + newLine);
+		output.write("}" + newLine);
+		output.write(newLine);
+
+		// Declaring a move constructor suppresses the implicit copy assignment operator. String defines its own.
+		if (!classFile.getClassName().asIdentifier().equals("java.lang.String"))
+		{
+			output.write(className + "& " + className + "::operator=(const " + className + "& object)" + newLine);
+			output.write("{" + newLine);
+			output.write("  shareJavaJniObject(object);" + newLine);
+			output.write("  return *this;" + newLine);
+			output.write("}" + newLine);
+		}
+		output.write("#endif" + newLine);
+		output.write(newLine);
+
 		// Now define the special "one-off" methods that we add to classes like,
 		// Object, String, and Throwable to provide better C++ and Java integration.
 		String fullyQualifiedName = classFile.getClassName().asIdentifier();
@@ -453,7 +532,7 @@ public class ProxyGenerator
 
 			output.write("String& String::operator=(const String& str)" + newLine);
 			output.write("{" + newLine);
-			output.write("  setJavaJniObject(str);" + newLine);
+			output.write("  shareJavaJniObject(str);" + newLine);
 			output.write("  return *this;" + newLine);
 			output.write("}" + newLine);
 			output.write(newLine);
@@ -1232,6 +1311,112 @@ public class ProxyGenerator
 		}
 	}
 
+	/**
+	 * Generates the definition of the overload of a method that returns a JResult
+	 * instead of throwing java exceptions as C++ exceptions.
+	 *
+	 * @param output the output writer
+	 * @param className the simple name of the proxy class
+	 * @param methodName the C++ name of the method
+	 * @param method the method
+	 * @param returnType the proxy of the return type of the method
+	 * @param parameters the parameter list of the method
+	 * @throws IOException if an error occurs while writing
+	 */
+	private void generateNothrowMethodDefinition(Writer output, String className, String methodName,
+																							 ClassMethod method, MetaClass returnType, String parameters)
+		throws IOException
+	{
+		String resultType = "::" + returnType.getFullyQualifiedName("::");
+		output.write("::jace::JResult< " + resultType + " > " + className + "::" + methodName + "(::jace::nothrow_t");
+		if (!parameters.isEmpty())
+			output.write(", " + parameters);
+		output.write(")" + newLine);
+		output.write("{" + newLine);
+
+		int parameterCount = method.getParameterTypes().size();
+		boolean useArgumentList = parameterCount > maxInlineArguments;
+		if (useArgumentList)
+		{
+			output.write("  JArguments arguments;" + newLine);
+			output.write("  arguments");
+			for (int i = 0; i < parameterCount; ++i)
+				output.write(" << p" + i);
+			output.write(";" + newLine);
+		}
+
+		generateSharedMember(output, "JMethod< " + resultType + " >", "method", className + "::staticGetJavaJniClass(), \""
+												 + method.getName() + "\", \"" + method.getDescriptor() + "\"");
+		output.write("  return method->tryInvoke(");
+		if (method.getAccessFlags().contains(MethodAccessFlag.STATIC))
+			output.write("staticGetJavaJniClass()");
+		else
+			output.write("*this");
+		if (useArgumentList)
+			output.write(", arguments");
+		else
+		{
+			for (int i = 0; i < parameterCount; ++i)
+				output.write(", p" + i);
+		}
+		output.write(");" + newLine);
+		output.write("}" + newLine);
+		output.write(newLine);
+	}
+
+	/**
+	 * Generates a function-local pointer to a JMethod or JConstructor, which the calls of the
+	 * function share. The object is created by the first call, and never deleted.
+	 *
+	 * It is created through boost::call_once, rather than as a function-local static object, as
+	 * C++03 compilers do not all initialize those thread-safely (Visual C++ before 2015, or GCC with
+	 * -fno-threadsafe-statics). The pointer and the once_flag are initialized statically.
+	 *
+	 * @param output the output writer
+	 * @param type the type of the object
+	 * @param name the name of the pointer
+	 * @param arguments the arguments of the constructor of the object
+	 * @throws IOException if an error occurs while writing
+	 */
+	private void generateSharedMember(Writer output, String type, String name, String arguments)
+		throws IOException
+	{
+		output.write("  static " + type + "* " + name + " = 0;" + newLine);
+		output.write("  static boost::once_flag " + name + "Flag = BOOST_ONCE_INIT;" + newLine);
+		output.write("  struct Create { static void create() { " + name + " = new " + type + "(" + arguments + "); } };"
+								 + newLine);
+		output.write("  boost::call_once(" + name + "Flag, &Create::create);" + newLine);
+	}
+
+	/**
+	 * Generates the definition of a method that attaches the current thread,
+	 * and forwards to the overload taking a JNIEnv.
+	 *
+	 * @param output the output writer
+	 * @param methodHead the return type and qualified name of the method
+	 * @param methodName the C++ name of the method
+	 * @param returnType the proxy of the return type of the method
+	 * @param parameters the parameter list of the method
+	 * @param parameterCount the number of parameters of the method
+	 * @throws IOException if an error occurs while writing
+	 */
+	private void generateAttachingMethodDefinition(Writer output, String methodHead, String methodName,
+																								 MetaClass returnType, String parameters, int parameterCount)
+		throws IOException
+	{
+		output.write(methodHead + "(" + parameters + ")" + newLine);
+		output.write("{" + newLine);
+		output.write("  ");
+		if (!returnType.getSimpleName().equals("JVoid"))
+			output.write("return ");
+		output.write(methodName + "(::jace::with_env, ::jace::attach()");
+		for (int i = 0; i < parameterCount; ++i)
+			output.write(", p" + i);
+		output.write(");" + newLine);
+		output.write("}" + newLine);
+		output.write(newLine);
+	}
+
 	/**
 	 * Generates the method declaration.
 	 *
@@ -1305,7 +1490,8 @@ public class ProxyGenerator
 				return result;
 			}
 		};
-		output.write(parameterList.toString(sf, ", ") + ")");
+		String parameters = parameterList.toString(sf, ", ");
+		output.write(parameters + ")");
 
 		if (!isConstructor && !accessFlagSet.contains(MethodAccessFlag.STATIC))
 		{
@@ -1315,6 +1501,37 @@ public class ProxyGenerator
 		}
 
 		output.write(";" + newLine);
+
+		if (!isConstructor && invokeStyle.equals(InvokeStyle.NORMAL))
+		{
+			Util.generateComment(output, methodName + newLine + newLine
+																	 + "Invokes the method through env, which must belong to the current thread.");
+			if (accessFlagSet.contains(MethodAccessFlag.STATIC))
+				output.write("static ");
+			MetaClass returnType = MetaClassFactory.getMetaClass(method.getReturnType()).proxy();
+			if (returnType.getSimpleName().equals("JVoid"))
+				output.write("void");
+			else
+				output.write("::" + returnType.getFullyQualifiedName("::"));
+			output.write(" " + methodName + "(::jace::with_env_t, JNIEnv* env");
+			if (!parameters.isEmpty())
+				output.write(", " + parameters);
+			output.write(");" + newLine);
+		}
+
+		if (exceptionsAsValues && !isConstructor && invokeStyle.equals(InvokeStyle.NORMAL))
+		{
+			Util.generateComment(output, methodName + newLine + newLine
+																	 + "Returns any java exception thrown by the method, instead of throwing it.");
+			if (accessFlagSet.contains(MethodAccessFlag.STATIC))
+				output.write("static ");
+			MetaClass returnType = MetaClassFactory.getMetaClass(method.getReturnType()).proxy();
+			output.write("::jace::JResult< ::" + returnType.getFullyQualifiedName("::") + " > " + methodName
+									 + "(::jace::nothrow_t");
+			if (!parameters.isEmpty())
+				output.write(", " + parameters);
+			output.write(");" + newLine);
+		}
 	}
 
 	/**
@@ -1364,6 +1581,19 @@ public class ProxyGenerator
 		Util.generateComment(output, "Copy an existing reference.");
 		output.write(metaClass.getSimpleName() + "(const " + metaClass.getSimpleName() + "&);" + newLine);
 
+		output.write("#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES" + newLine);
+		Util.generateComment(output, "Take over an existing reference, leaving a null reference behind.");
+		output.write(metaClass.getSimpleName() + "(" + metaClass.getSimpleName() + "&&);" + newLine);
+		output.write(metaClass.getSimpleName() + "& operator=(" + metaClass.getSimpleName() + "&&);" + newLine);
+		if (!fullyQualifiedName.equals("java.lang.String"))
+		{
+			Util.generateComment(output, "Copy an existing reference.");
+			output.write(metaClass.getSimpleName() + "& operator=(const " + metaClass.getSimpleName() + "&);"
+									 + newLine);
+		}
+		output.write("#endif" + newLine);
+		output.write(newLine);
+
 		output.write(nonConstructors.toString());
 
 		output.write("virtual const JClass& getJavaJniClass() const;"
@@ -1656,6 +1886,8 @@ public class ProxyGenerator
 		output.write("#include \"jace/JMethod.h\"" + newLine);
 		output.write("#include \"jace/JField.h\"" + newLine);
 		output.write("#include \"jace/JClassImpl.h\"" + newLine);
+		if (exceptionsAsValues)
+			output.write("#include \"jace/JResult.h\"" + newLine);
 		output.write(newLine);
 
 		String className = classFile.getClassName().asIdentifier();
@@ -1906,6 +2138,8 @@ public class ProxyGenerator
 					 + "    -package: Generate public, protected, package-private fields and methods."
 					 + newLine
 					 + "    -private: Generate public, protected, package-private, private fields and methods."
+					 + newLine
+					 + "    -nothrow: Also generate overloads of methods that return java exceptions in a JResult."
 					 + newLine;
 	}
 
@@ -1921,6 +2155,7 @@ public class ProxyGenerator
 		private final MetaClassFilter dependencyFilter;
 		private final ClassPath classPath;
 		private AccessibilityType accessibility = AccessibilityType.PUBLIC;
+		private boolean exceptionsAsValues;
 
 		/**
 		 * Creates a new Builder.
@@ -1962,6 +2197,19 @@ public class ProxyGenerator
 			return this;
 		}
 
+		/**
+		 * Indicates whether methods should get an overload taking {@code jace::nothrow}, which
+		 * returns java exceptions in a {@code jace::JResult} instead of throwing them.
+		 *
+		 * @param exceptionsAsValues true if the overloads should be generated. The default is false.
+		 * @return the Builder
+		 */
+		public Builder exceptionsAsValues(boolean exceptionsAsValues)
+		{
+			this.exceptionsAsValues = exceptionsAsValues;
+			return this;
+		}
+
 		/**
 		 * Builds a ProxyGenerator.
 		 *
@@ -2030,6 +2278,7 @@ public class ProxyGenerator
 		}
 
 		AccessibilityType accessibility = AccessibilityType.PUBLIC;
+		boolean exceptionsAsValues = false;
 		for (int i = 2; i < args.length; ++i)
 		{
 			String option = args[i];
@@ -2055,6 +2304,11 @@ public class ProxyGenerator
 					accessibility = AccessibilityType.PRIVATE;
 					break;
 				}
+				case "-nothrow":
+				{
+					exceptionsAsValues = true;
+					break;
+				}
 				default:
 				{
 					System.out.println("Not an understood option: " + option);
@@ -2069,7 +2323,7 @@ public class ProxyGenerator
 		{
 			ProxyGenerator generator = new ProxyGenerator.Builder(new ClassPath(System.getProperty(
 				"java.class.path")), new ClassFile(new File(args[0])), new AcceptAll()).
-				accessibility(accessibility).build();
+				accessibility(accessibility).exceptionsAsValues(exceptionsAsValues).build();
 			OutputStreamWriter writer = new OutputStreamWriter(System.out);
 			switch (args[1])
 			{
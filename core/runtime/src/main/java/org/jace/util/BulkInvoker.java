@@ -0,0 +1,239 @@
+package org.jace.util;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Executes a batch of method calls on behalf of native code, so that the whole batch
+ * crosses the JNI boundary once.
+ *
+ * Methods are bound once, with {@link #bind}, which returns the index of the target.
+ * A batch is then described by a buffer of 8-byte slots in native byte order, plus an
+ * array of objects. Each call in the buffer is laid out as:
+ * <pre>
+ *   [target index] [result] [argument 0] ... [argument n-1]
+ * </pre>
+ * Primitive arguments hold their value (floats and doubles as their raw bits), reference
+ * arguments hold an index into the object array. For virtual methods, the receiver is
+ * the first argument.
+ *
+ * Once a call returns, a primitive result is written to its result slot. A reference result
+ * is stored in the object array, at the index held by the result slot.
+ */
+public final class BulkInvoker {
+    public static final int VIRTUAL = 0;
+    public static final int STATIC = 1;
+    public static final int CONSTRUCTOR = 2;
+
+    /** The bound targets, and a snapshot of them for lock-free reads */
+    private static final List<Target> targets = new ArrayList<>();
+    private static volatile Target[] snapshot = new Target[0];
+
+    private BulkInvoker() {}
+
+    /**
+     * Binds a method, for use in later batches.
+     *
+     * @param clazz the class declaring the method
+     * @param name the name of the method, ignored for constructors
+     * @param descriptor the JNI descriptor of the method, such as "(ILjava/lang/String;)V"
+     * @param kind one of VIRTUAL, STATIC or CONSTRUCTOR
+     * @return the index of the target
+     */
+    public static synchronized int bind(final Class<?> clazz, final String name, final String descriptor,
+                                        final int kind) throws NoSuchMethodException, IllegalAccessException {
+        final MethodType type = MethodType.fromMethodDescriptorString(descriptor, clazz.getClassLoader());
+        final MethodHandles.Lookup lookup = MethodHandles.publicLookup();
+        final MethodHandle handle;
+        switch (kind) {
+            case VIRTUAL:
+                handle = lookup.findVirtual(clazz, name, type);
+                break;
+            case STATIC:
+                handle = lookup.findStatic(clazz, name, type);
+                break;
+            case CONSTRUCTOR:
+                handle = lookup.findConstructor(clazz, type);
+                break;
+            default:
+                throw new IllegalArgumentException("Unknown kind of method: " + kind);
+        }
+        targets.add(new Target(handle));
+        snapshot = targets.toArray(new Target[targets.size()]);
+        return targets.size() - 1;
+    }
+
+    /**
+     * Executes a batch of calls.
+     *
+     * The batch stops at the first call that throws, the results of the calls before it are valid.
+     *
+     * @param buffer the calls, as described above
+     * @param count the number of calls in the buffer
+     * @param objects the reference arguments and results
+     */
+    public static void execute(final ByteBuffer buffer, final int count, final Object[] objects) throws Throwable {
+        final Cursor cursor = new Cursor(buffer.order(ByteOrder.nativeOrder()), objects);
+        final Target[] bound = snapshot;
+        for (int i = 0; i < count; ++i) {
+            final Target target = bound[(int) cursor.calls.getLong(cursor.position)];
+            target.invoker.invokeExact(cursor);
+            cursor.position += target.size;
+        }
+    }
+
+    /**
+     * The position of the call being executed in a batch. The invokers of the targets read
+     * their arguments and write their result through it.
+     */
+    static final class Cursor {
+        final ByteBuffer calls;
+        final Object[] objects;
+        int position;
+
+        Cursor(final ByteBuffer calls, final Object[] objects) {
+            this.calls = calls;
+            this.objects = objects;
+        }
+    }
+
+    // The pieces the invokers of the targets are assembled from. Arguments are decoded straight
+    // into their parameter types, and results encoded from their return type, so that no call
+    // allocates an argument array or boxes a primitive.
+
+    private static long slot(final Cursor cursor, final int offset) {
+        return cursor.calls.getLong(cursor.position + offset);
+    }
+
+    private static Object object(final Cursor cursor, final int offset) {
+        return cursor.objects[(int) slot(cursor, offset)];
+    }
+
+    private static int toInt(final long bits) {
+        return (int) bits;
+    }
+
+    private static boolean toBoolean(final long bits) {
+        return bits != 0;
+    }
+
+    private static double toDouble(final long bits) {
+        return Double.longBitsToDouble(bits);
+    }
+
+    private static float toFloat(final long bits) {
+        return Float.intBitsToFloat((int) bits);
+    }
+
+    private static byte toByte(final long bits) {
+        return (byte) bits;
+    }
+
+    private static char toChar(final long bits) {
+        return (char) bits;
+    }
+
+    private static short toShort(final long bits) {
+        return (short) bits;
+    }
+
+    private static void putLong(final long value, final Cursor cursor) {
+        cursor.calls.putLong(cursor.position + 8, value);
+    }
+
+    private static void putBoolean(final boolean value, final Cursor cursor) {
+        putLong(value ? 1 : 0, cursor);
+    }
+
+    private static void putFloat(final float value, final Cursor cursor) {
+        putLong(Float.floatToRawIntBits(value) & 0xffffffffL, cursor);
+    }
+
+    private static void putDouble(final double value, final Cursor cursor) {
+        putLong(Double.doubleToRawLongBits(value), cursor);
+    }
+
+    private static void putObject(final Object value, final Cursor cursor) {
+        cursor.objects[(int) cursor.calls.getLong(cursor.position + 8)] = value;
+    }
+
+    private static MethodHandle helper(final String name, final Class<?> returnType, final Class<?>... parameterTypes)
+            throws NoSuchMethodException, IllegalAccessException {
+        return MethodHandles.lookup().findStatic(BulkInvoker.class, name,
+                                                 MethodType.methodType(returnType, parameterTypes));
+    }
+
+    /**
+     * Returns a handle that reads the argument at a slot of the current call, as the given type.
+     */
+    private static MethodHandle decoder(final Class<?> type, final int offset)
+            throws NoSuchMethodException, IllegalAccessException {
+        if (!type.isPrimitive()) {
+            final MethodHandle object = helper("object", Object.class, Cursor.class, int.class);
+            return MethodHandles.insertArguments(object, 1, offset).asType(MethodType.methodType(type, Cursor.class));
+        }
+
+        final MethodHandle slot = MethodHandles.insertArguments(helper("slot", long.class, Cursor.class, int.class),
+                                                                1, offset);
+        if (type == long.class) {
+            return slot;
+        }
+        final String name = "to" + Character.toUpperCase(type.getName().charAt(0)) + type.getName().substring(1);
+        return MethodHandles.filterReturnValue(slot, helper(name, type, long.class));
+    }
+
+    /**
+     * Returns a handle that writes a value of the given type to the result slot of the current call.
+     */
+    private static MethodHandle encoder(final Class<?> type) throws NoSuchMethodException, IllegalAccessException {
+        final MethodHandle encoder;
+        if (!type.isPrimitive()) {
+            encoder = helper("putObject", void.class, Object.class, Cursor.class);
+        } else if (type == boolean.class) {
+            encoder = helper("putBoolean", void.class, boolean.class, Cursor.class);
+        } else if (type == float.class) {
+            encoder = helper("putFloat", void.class, float.class, Cursor.class);
+        } else if (type == double.class) {
+            encoder = helper("putDouble", void.class, double.class, Cursor.class);
+        } else {
+            // Bytes, chars, shorts and ints widen to long, as they would through Number.longValue()
+            encoder = helper("putLong", void.class, long.class, Cursor.class);
+        }
+        return encoder.asType(MethodType.methodType(void.class, type, Cursor.class));
+    }
+
+    /**
+     * A bound method, adapted to read its arguments from a batch and write its result back to it
+     */
+    private static final class Target {
+        final MethodHandle invoker;
+        /** The number of bytes the call takes in the buffer */
+        final int size;
+
+        private Target(final MethodHandle handle) throws NoSuchMethodException, IllegalAccessException {
+            final MethodType type = handle.type();
+            final Class<?>[] parameters = type.parameterArray();
+            this.size = (2 + parameters.length) * 8;
+
+            // Decode every argument from the cursor, then pass the one cursor to all of the decoders
+            final MethodHandle[] decoders = new MethodHandle[parameters.length];
+            for (int p = 0; p < parameters.length; ++p) {
+                decoders[p] = decoder(parameters[p], 16 + 8 * p);
+            }
+            final MethodHandle decoded = MethodHandles.permuteArguments(
+                MethodHandles.filterArguments(handle, 0, decoders),
+                MethodType.methodType(type.returnType(), Cursor.class), new int[parameters.length]);
+
+            if (type.returnType() == void.class) {
+                this.invoker = decoded;
+            } else {
+                this.invoker = MethodHandles.foldArguments(encoder(type.returnType()), decoded);
+            }
+        }
+    }
+}
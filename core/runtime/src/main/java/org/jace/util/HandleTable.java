@@ -0,0 +1,186 @@
+package org.jace.util;
+
+import java.util.Arrays;
+
+/**
+ * A table of objects, addressed by int handles, on behalf of native code.
+ *
+ * Native code that keeps many java objects can store them in a HandleTable, and hold their
+ * handles, instead of holding one JNI global reference per object. The virtual machine then
+ * only sees the global reference to the table, whatever the number of objects in it.
+ *
+ * A handle is the index of its slot plus one, so that 0 stands for null. The slots of removed
+ * objects are reused by later insertions.
+ */
+public final class HandleTable {
+    private static final int DEFAULT_CAPACITY = 64;
+
+    /** The objects, by slot. Free slots hold null */
+    private Object[] objects;
+
+    /** For each free slot, the next free slot, or -1 */
+    private int[] nextFree;
+
+    /** The first free slot, or -1 */
+    private int firstFree = -1;
+
+    /** The number of slots that have been used at least once */
+    private int used;
+
+    /** The number of objects in the table */
+    private int size;
+
+    /**
+     * Creates an empty table.
+     */
+    public HandleTable() {
+        this(DEFAULT_CAPACITY);
+    }
+
+    /**
+     * Creates an empty table, with room for capacity objects.
+     *
+     * @param capacity the initial capacity of the table
+     */
+    public HandleTable(final int capacity) {
+        if (capacity < 0) {
+            throw new IllegalArgumentException("Negative capacity: " + capacity);
+        }
+        objects = new Object[capacity];
+        nextFree = new int[capacity];
+    }
+
+    /**
+     * Adds an object to the table.
+     *
+     * @param object the object, or null
+     * @return the handle of the object, or 0 if object is null
+     */
+    public synchronized int add(final Object object) {
+        if (object == null) {
+            return 0;
+        }
+        final int slot;
+        if (firstFree >= 0) {
+            slot = firstFree;
+            firstFree = nextFree[slot];
+        } else {
+            if (used == objects.length) {
+                grow(used + 1);
+            }
+            slot = used++;
+        }
+        objects[slot] = object;
+        ++size;
+        return slot + 1;
+    }
+
+    /**
+     * Adds the first count objects of an array to the table.
+     *
+     * @param objects the objects, which may contain nulls
+     * @param count the number of objects to add
+     * @return the handles of the objects, 0 for nulls
+     */
+    public synchronized int[] addAll(final Object[] objects, final int count) {
+        if (firstFree < 0 && used + count > this.objects.length) {
+            grow(used + count);
+        }
+        final int[] handles = new int[count];
+        for (int i = 0; i < count; ++i) {
+            handles[i] = add(objects[i]);
+        }
+        return handles;
+    }
+
+    /**
+     * Returns the object of a handle.
+     *
+     * @param handle the handle
+     * @return the object, or null if handle is 0
+     * @throws IllegalArgumentException if the handle is not in the table
+     */
+    public synchronized Object get(final int handle) {
+        if (handle == 0) {
+            return null;
+        }
+        return objects[checkSlot(handle)];
+    }
+
+    /**
+     * Returns the objects of the first count handles of an array.
+     *
+     * @param handles the handles, which may contain zeros
+     * @param count the number of handles
+     * @return the objects, null for zeros
+     * @throws IllegalArgumentException if a handle is not in the table
+     */
+    public synchronized Object[] getAll(final int[] handles, final int count) {
+        final Object[] result = new Object[count];
+        for (int i = 0; i < count; ++i) {
+            result[i] = get(handles[i]);
+        }
+        return result;
+    }
+
+    /**
+     * Removes the object of a handle from the table. The handle may be reused afterwards.
+     *
+     * @param handle the handle, ignored if 0
+     * @throws IllegalArgumentException if the handle is not in the table
+     */
+    public synchronized void remove(final int handle) {
+        if (handle == 0) {
+            return;
+        }
+        final int slot = checkSlot(handle);
+        objects[slot] = null;
+        nextFree[slot] = firstFree;
+        firstFree = slot;
+        --size;
+    }
+
+    /**
+     * Removes the objects of the first count handles of an array from the table.
+     *
+     * @param handles the handles, zeros are ignored
+     * @param count the number of handles
+     * @throws IllegalArgumentException if a handle is not in the table. The handles before it are removed.
+     */
+    public synchronized void removeAll(final int[] handles, final int count) {
+        for (int i = 0; i < count; ++i) {
+            remove(handles[i]);
+        }
+    }
+
+    /**
+     * Removes every object from the table, invalidating every handle.
+     */
+    public synchronized void clear() {
+        Arrays.fill(objects, 0, used, null);
+        firstFree = -1;
+        used = 0;
+        size = 0;
+    }
+
+    /**
+     * Returns the number of objects in the table.
+     */
+    public synchronized int size() {
+        return size;
+    }
+
+    private int checkSlot(final int handle) {
+        final int slot = handle - 1;
+        if (slot < 0 || slot >= used || objects[slot] == null) {
+            throw new IllegalArgumentException("Invalid handle: " + handle);
+        }
+        return slot;
+    }
+
+    private void grow(final int minimum) {
+        final int capacity = Math.max(minimum, objects.length + (objects.length >> 1) + 1);
+        objects = Arrays.copyOf(objects, capacity);
+        nextFree = Arrays.copyOf(nextFree, capacity);
+    }
+}
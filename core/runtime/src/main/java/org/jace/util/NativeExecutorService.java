@@ -0,0 +1,134 @@
+package org.jace.util;
+
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.AbstractExecutorService;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * An ExecutorService running its tasks on a native thread pool, a jace::JvmExecutor.
+ *
+ * The pool itself is exposed as a plain {@link Executor}, a native proxy created by
+ * jace::runtime::createExecutor(). This class adds the lifecycle of an ExecutorService
+ * on top of it: shutting it down stops it from accepting tasks, and it terminates once
+ * the tasks it accepted have run. The native pool is owned by native code, and is not
+ * shut down along with this service.
+ *
+ * Tasks that were accepted cannot be taken back from the native pool, so
+ * {@link #shutdownNow} does not return any.
+ *
+ * The native pool drops a task without running it if its worker is out of memory, or
+ * the virtual machine is shutting down. Such a task is never recorded as done, so the
+ * service does not terminate, and {@link #awaitTermination} waits until its timeout.
+ */
+public final class NativeExecutorService extends AbstractExecutorService {
+    /** The native pool */
+    private final Executor executor;
+
+    /** The number of accepted tasks that have not run yet, guarded by lock */
+    private final Object lock = new Object();
+    private int active;
+    private boolean shutdown;
+
+    /**
+     * Creates a service running its tasks on the given native executor.
+     */
+    public NativeExecutorService(final Executor executor) {
+        if (executor == null) {
+            throw new NullPointerException("executor");
+        }
+        this.executor = executor;
+    }
+
+    @Override public void execute(final Runnable command) {
+        if (command == null) {
+            throw new NullPointerException("command");
+        }
+        synchronized (lock) {
+            if (shutdown) {
+                throw new RejectedExecutionException("The executor has been shut down");
+            }
+            ++active;
+        }
+
+        try {
+            executor.execute(new Task(command));
+        } catch (final RuntimeException e) {
+            finished();
+            throw e;
+        }
+    }
+
+    @Override public void shutdown() {
+        synchronized (lock) {
+            shutdown = true;
+            if (active == 0) {
+                lock.notifyAll();
+            }
+        }
+    }
+
+    @Override public List<Runnable> shutdownNow() {
+        shutdown();
+        return Collections.emptyList();
+    }
+
+    @Override public boolean isShutdown() {
+        synchronized (lock) {
+            return shutdown;
+        }
+    }
+
+    @Override public boolean isTerminated() {
+        synchronized (lock) {
+            return shutdown && active == 0;
+        }
+    }
+
+    @Override public boolean awaitTermination(final long timeout, final TimeUnit unit) throws InterruptedException {
+        final long deadline = System.nanoTime() + unit.toNanos(timeout);
+        synchronized (lock) {
+            while (!(shutdown && active == 0)) {
+                final long remaining = deadline - System.nanoTime();
+                if (remaining <= 0) {
+                    return false;
+                }
+                TimeUnit.NANOSECONDS.timedWait(lock, remaining);
+            }
+            return true;
+        }
+    }
+
+    /**
+     * Records that an accepted task has run, or was rejected by the native pool
+     */
+    private void finished() {
+        synchronized (lock) {
+            --active;
+            if (shutdown && active == 0) {
+                lock.notifyAll();
+            }
+        }
+    }
+
+    /**
+     * Runs a task, and records when it is done
+     */
+    private final class Task implements Runnable {
+        private final Runnable command;
+
+        private Task(final Runnable command) {
+            this.command = command;
+        }
+
+        @Override public void run() {
+            try {
+                command.run();
+            } finally {
+                finished();
+            }
+        }
+    }
+}
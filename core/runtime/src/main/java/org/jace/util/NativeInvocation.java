@@ -55,7 +55,22 @@ public class NativeInvocation implements InvocationHandler {
         return Proxy.newProxyInstance(clazz.getClassLoader(), new Class[] { clazz }, this);
 	}
 
+	/**
+	 * Creates a new instance of a proxy class for this invocation, whose callbacks
+	 * receive the given native context
+	 */
+	public Object createProxy(final long context) {
+        return Proxy.newProxyInstance(clazz.getClassLoader(), new Class[] { clazz }, new ContextHandler(context));
+	}
+
     @Override public Object invoke(final Object proxy, final Method method, final Object[] args) {
+        return invoke(proxy, method, args, 0);
+    }
+
+    /**
+     * Dispatches a method to its callback, passing the context along if there is one
+     */
+    private Object invoke(final Object proxy, final Method method, final Object[] args, final long context) {
         if (!callbackMap.containsKey(method.getName())) {
             switch(method.getName()) {
                 case EQUALS:
@@ -69,13 +84,36 @@ public class NativeInvocation implements InvocationHandler {
             }
         }
         Callback c = callbackMap.get(method.getName());
-        return invokeNative(c.ref, c.idx, proxy, args);
+        if (context == 0) {
+            return invokeNative(c.ref, c.idx, proxy, args);
+        }
+        return invokeNativeWithContext(c.ref, c.idx, context, proxy, args);
     }
 
 	/**
 	 * The native callback our invocation handler makes
 	 */
 	private native Object invokeNative(final long ref, final int idx, final Object proxy, final Object[] args);
+
+	/**
+	 * The native callback made for proxies that were created with a context
+	 */
+	private native Object invokeNativeWithContext(final long ref, final int idx, final long context,
+	                                              final Object proxy, final Object[] args);
+
+    /**
+     * The invocation handler of proxies that were created with a context
+     */
+    private class ContextHandler implements InvocationHandler {
+        final long context;
+        private ContextHandler(final long context) {
+            this.context = context;
+        }
+
+        @Override public Object invoke(final Object proxy, final Method method, final Object[] args) {
+            return NativeInvocation.this.invoke(proxy, method, args, context);
+        }
+    }
     
     /**
      * A class to hold our callback information
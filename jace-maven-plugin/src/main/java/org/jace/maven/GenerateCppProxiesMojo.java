@@ -86,6 +86,13 @@ public class GenerateCppProxiesMojo
 	 * @parameter default-value="true"
 	 */
 	private boolean minimizeDependencies;
+	/**
+	 * Indicates whether methods should get an overload taking jace::nothrow, which returns
+	 * java exceptions in a jace::JResult instead of throwing them.
+	 *
+	 * @parameter default-value="false"
+	 */
+	private boolean exceptionsAsValues;
 	/**
 	 * A list of fully-qualified class names that must be exported.
 	 *
@@ -125,7 +132,7 @@ public class GenerateCppProxiesMojo
 			classpathList = Arrays.asList(classpath);
 		AutoProxy.Builder autoProxy = new AutoProxy.Builder(inputHeaderFiles, inputSourceFiles,
 			outputHeaders, outputSources, new ClassPath(classpathList)).accessibility(accessibilityType).
-			minimizeDependencies(minimizeDependencies);
+			minimizeDependencies(minimizeDependencies).exceptionsAsValues(exceptionsAsValues);
 		for (TypeName dependency: extraDependencies)
 			autoProxy.extraDependency(dependency);
 		try